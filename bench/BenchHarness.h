@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file BenchHarness.h
+ * @brief Minimal microbenchmark harness for the LogAnywhere hot path.
+ *
+ * Each benchmark is a callable taking an iteration count.  The runner:
+ *  1) calibrates the batch size so one sample takes about sampleMs,
+ *  2) warms up for warmupMs (caches, branch predictors, CPU clocks),
+ *  3) takes `samples` timed batches and reports the median ns/op, the
+ *     fastest batch and the median absolute deviation, so one noisy batch
+ *     cannot move the headline number.
+ *
+ * While the timed samples run, hardware counters (PerfCounters.h) are
+ * collected and reported per operation; they print as "-" where the
+ * platform does not provide them.  Pass --no-counters to skip them.
+ *
+ * Results go to stdout as an aligned table, or as CSV with --csv.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "PerfCounters.h"
+
+namespace LogAnywhereBench
+{
+
+    /// Keeps @p value alive so the optimizer cannot drop the work producing it.
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /// Monotonic time in nanoseconds.
+    inline uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /**
+     * @brief Summary statistics for one benchmark.
+     */
+    struct BenchResult
+    {
+        const char *name;     ///< Benchmark name
+        uint64_t batch;       ///< Iterations per timed sample
+        int samples;          ///< Number of timed samples
+        double nsPerOp;       ///< Median ns per iteration
+        double minNsPerOp;    ///< Fastest sample
+        double madPercent;    ///< Median absolute deviation, % of median
+        double opsPerSec;     ///< Throughput at the median
+        double perOp[PERF_EVENT_COUNT]; ///< Hardware events per op (< 0 = unavailable)
+    };
+
+    /**
+     * @brief Runner options, settable from the command line.
+     */
+    struct BenchConfig
+    {
+        double warmupMs = 100.0; ///< Warmup time per benchmark
+        double sampleMs = 20.0;  ///< Target duration of one sample
+        int samples = 15;        ///< Timed samples per benchmark
+        bool csv = false;        ///< Emit CSV instead of a table
+        bool counters = true;    ///< Collect hardware counters when available
+        const char *filter = nullptr; ///< Only run names containing this
+
+        /**
+         * @brief Parses --quick, --csv, --no-counters, --samples N and --filter S.
+         * @return false on an unknown argument (usage is printed).
+         */
+        bool parse(int argc, char **argv)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                if (!std::strcmp(argv[i], "--quick"))
+                {
+                    warmupMs = 5.0;
+                    sampleMs = 2.0;
+                    samples = 5;
+                }
+                else if (!std::strcmp(argv[i], "--csv"))
+                    csv = true;
+                else if (!std::strcmp(argv[i], "--no-counters"))
+                    counters = false;
+                else if (!std::strcmp(argv[i], "--samples") && i + 1 < argc)
+                    samples = std::max(1, std::atoi(argv[++i]));
+                else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+                    filter = argv[++i];
+                else
+                {
+                    std::fprintf(stderr, "usage: %s [--quick] [--csv] [--no-counters] [--samples N] [--filter NAME]\n", argv[0]);
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief Calibrates, warms up, samples and prints each benchmark.
+     */
+    class BenchRunner
+    {
+    public:
+        explicit BenchRunner(const BenchConfig &cfg) : cfg(cfg), headerPrinted(false)
+        {
+            if (cfg.counters && perf.open() == 0)
+                std::fprintf(stderr, "note: hardware counters unavailable (perf_event_open failed)\n");
+        }
+
+        /**
+         * @brief Runs one benchmark and prints its result line.
+         *
+         * @param name  Benchmark name.
+         * @param body  Callable `void(uint64_t iterations)` doing the work.
+         * @return The measured statistics (name == nullptr if filtered out).
+         */
+        template <typename Body>
+        BenchResult run(const char *name, Body &&body)
+        {
+            BenchResult r{};
+            if (cfg.filter && !std::strstr(name, cfg.filter))
+                return r;
+
+            uint64_t batch = calibrate(body);
+            uint64_t warmupEnd = nowNs() + static_cast<uint64_t>(cfg.warmupMs * 1e6);
+            while (nowNs() < warmupEnd)
+                body(batch);
+
+            std::vector<double> perOp(static_cast<size_t>(cfg.samples));
+            perf.clear();
+            for (double &v : perOp)
+            {
+                perf.start();
+                uint64_t t0 = nowNs();
+                body(batch);
+                uint64_t t1 = nowNs();
+                perf.stop();
+                v = static_cast<double>(t1 - t0) / static_cast<double>(batch);
+            }
+            double ops = static_cast<double>(batch) * cfg.samples;
+            for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+                r.perOp[e] = perf.available(static_cast<PerfEvent>(e))
+                                 ? static_cast<double>(perf.total(static_cast<PerfEvent>(e))) / ops
+                                 : -1.0;
+
+            r.name = name;
+            r.batch = batch;
+            r.samples = cfg.samples;
+            r.nsPerOp = median(perOp);
+            r.minNsPerOp = *std::min_element(perOp.begin(), perOp.end());
+            for (double &v : perOp)
+                v = std::fabs(v - r.nsPerOp);
+            r.madPercent = r.nsPerOp > 0 ? 100.0 * median(perOp) / r.nsPerOp : 0.0;
+            r.opsPerSec = r.nsPerOp > 0 ? 1e9 / r.nsPerOp : 0.0;
+            print(r);
+            return r;
+        }
+
+    private:
+        BenchConfig cfg;
+        bool headerPrinted;
+        PerfCounters perf;
+
+        /// Doubles the batch until one batch takes at least sampleMs.
+        template <typename Body>
+        uint64_t calibrate(Body &body)
+        {
+            const uint64_t target = static_cast<uint64_t>(cfg.sampleMs * 1e6);
+            uint64_t batch = 1;
+            for (;;)
+            {
+                uint64_t t0 = nowNs();
+                body(batch);
+                uint64_t took = nowNs() - t0;
+                if (took >= target || batch >= (uint64_t(1) << 30))
+                    return batch;
+                // Jump close to the target once the timing is meaningful
+                if (took > 100000)
+                    return std::max<uint64_t>(batch, batch * target / took);
+                batch *= 2;
+            }
+        }
+
+        static double median(std::vector<double> v)
+        {
+            std::sort(v.begin(), v.end());
+            size_t n = v.size();
+            return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+        }
+
+        void print(const BenchResult &r)
+        {
+            if (!headerPrinted)
+            {
+                if (cfg.csv)
+                {
+                    std::printf("name,ns_per_op,min_ns_per_op,mad_percent,ops_per_sec,batch,samples");
+                    for (const char *n : PERF_EVENT_NAMES)
+                        std::printf(",%s_per_op", n);
+                    std::printf(",ipc\n");
+                }
+                else
+                {
+                    std::printf("%-32s %10s %10s %7s %14s", "benchmark", "ns/op", "min", "mad%", "ops/s");
+                    for (const char *n : PERF_EVENT_NAMES)
+                        std::printf(" %10s", n);
+                    std::printf(" %6s\n", "ipc");
+                }
+                headerPrinted = true;
+            }
+            if (cfg.csv)
+                std::printf("%s,%.3f,%.3f,%.2f,%.0f,%llu,%d", r.name, r.nsPerOp, r.minNsPerOp,
+                            r.madPercent, r.opsPerSec, static_cast<unsigned long long>(r.batch), r.samples);
+            else
+                std::printf("%-32s %10.2f %10.2f %7.2f %14.0f", r.name, r.nsPerOp, r.minNsPerOp,
+                            r.madPercent, r.opsPerSec);
+
+            for (double v : r.perOp)
+            {
+                if (v < 0)
+                    std::printf(cfg.csv ? "," : " %10s", "-");
+                else
+                    std::printf(cfg.csv ? ",%.4f" : " %10.3f", v);
+            }
+            bool haveIpc = r.perOp[PERF_CYCLES] > 0 && r.perOp[PERF_INSTRUCTIONS] >= 0;
+            double ipc = haveIpc ? r.perOp[PERF_INSTRUCTIONS] / r.perOp[PERF_CYCLES] : 0.0;
+            if (cfg.csv)
+                haveIpc ? std::printf(",%.3f\n", ipc) : std::printf(",\n");
+            else
+                haveIpc ? std::printf(" %6.2f\n", ipc) : std::printf(" %6s\n", "-");
+            std::fflush(stdout);
+        }
+    };
+
+} // namespace LogAnywhereBench
@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file PerfCounters.h
+ * @brief Hardware performance counters for benchmarks via perf_event_open.
+ *
+ * Counts cycles, instructions, cache misses and branch misses for the
+ * calling thread, user space only (works with perf_event_paranoid ≤ 2).
+ * Each counter is opened on its own, so a PMU that lacks one event still
+ * reports the others; when perf is unavailable altogether (non-Linux,
+ * containers, VMs without a virtual PMU, seccomp) every counter simply
+ * reports as unavailable and benchmarks keep running.
+ *
+ * Counts are scaled by time-enabled / time-running to correct for
+ * multiplexing when the PMU has fewer slots than requested events.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace LogAnywhereBench
+{
+
+    /**
+     * @brief The events collected around each benchmark.
+     */
+    enum PerfEvent
+    {
+        PERF_CYCLES = 0,
+        PERF_INSTRUCTIONS,
+        PERF_CACHE_MISSES,
+        PERF_BRANCH_MISSES,
+        PERF_EVENT_COUNT
+    };
+
+    /// Short column names, indexed by PerfEvent.
+    static const char *const PERF_EVENT_NAMES[PERF_EVENT_COUNT] = {"cycles", "instr", "cache_miss", "br_miss"};
+
+    /**
+     * @brief Per-thread set of hardware counters.
+     */
+    class PerfCounters
+    {
+    public:
+        PerfCounters()
+        {
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+            {
+                fds[i] = -1;
+                totals[i] = 0;
+            }
+        }
+
+        ~PerfCounters() { close(); }
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        /**
+         * @brief Opens every counter the kernel and CPU allow.
+         * @return Number of counters that opened (0 = none available).
+         */
+        int open()
+        {
+            close();
+            int opened = 0;
+#if defined(__linux__)
+            static const uint64_t configs[PERF_EVENT_COUNT] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+            {
+                struct perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[i];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if (fds[i] >= 0)
+                    ++opened;
+            }
+#endif
+            return opened;
+        }
+
+        /// Closes all counters.
+        void close()
+        {
+#if defined(__linux__)
+            for (int &fd : fds)
+            {
+                if (fd >= 0)
+                    ::close(fd);
+                fd = -1;
+            }
+#endif
+        }
+
+        /// @return true if @p event opened successfully.
+        bool available(PerfEvent event) const { return fds[event] >= 0; }
+
+        /// @return true if at least one counter is available.
+        bool anyAvailable() const
+        {
+            for (int fd : fds)
+                if (fd >= 0)
+                    return true;
+            return false;
+        }
+
+        /// Zeroes the accumulated totals.
+        void clear()
+        {
+            for (auto &t : totals)
+                t = 0;
+        }
+
+        /// Resets and enables the counters (call right before the measured code).
+        void start()
+        {
+#if defined(__linux__)
+            for (int fd : fds)
+            {
+                if (fd < 0)
+                    continue;
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        /// Disables the counters and adds their scaled values to the totals.
+        void stop()
+        {
+#if defined(__linux__)
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+            {
+                if (fds[i] < 0)
+                    continue;
+                ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t v[3] = {0, 0, 0}; // value, time enabled, time running
+                if (read(fds[i], v, sizeof(v)) != static_cast<ssize_t>(sizeof(v)))
+                    continue;
+                if (v[2] > 0 && v[2] < v[1])
+                    v[0] = static_cast<uint64_t>(static_cast<double>(v[0]) * v[1] / v[2]);
+                totals[i] += v[0];
+            }
+#endif
+        }
+
+        /// @return Accumulated count for @p event since clear().
+        uint64_t total(PerfEvent event) const { return totals[event]; }
+
+    private:
+        int fds[PERF_EVENT_COUNT];
+        uint64_t totals[PERF_EVENT_COUNT];
+    };
+
+} // namespace LogAnywhereBench
@@ -0,0 +1,113 @@
+/**
+ * @file bench_logger.cpp
+ * @brief Single-thread microbenchmarks of the LogAnywhere hot path.
+ *
+ * Build target: loganywhere_bench (always optimized, never instrumented).
+ *
+ *   loganywhere_bench [--quick] [--csv] [--samples N] [--filter NAME]
+ */
+
+// Room for the 16-handler case
+#define LOGANYWHERE_MAX_HANDLERS 32
+
+#include "../include/LogAnywhere.h"
+#include "BenchHarness.h"
+
+using namespace LogAnywhere;
+using namespace LogAnywhereBench;
+
+namespace
+{
+    /// Cheapest possible sink: bump a counter and touch the message.
+    void countingSink(const LogMessage &msg, void *ctx)
+    {
+        ++*static_cast<uint64_t *>(ctx);
+        doNotOptimize(msg.message);
+    }
+
+    /// Benchmarks Logger::log with @p handlers subscribers on one tag.
+    void benchFanOut(BenchRunner &runner, const char *name, size_t handlers)
+    {
+        Tag tag("BENCH");
+        HandlerManager mgr;
+        Logger logger(&mgr);
+        const Tag *tags[] = {&tag};
+        uint64_t delivered = 0;
+        for (size_t i = 0; i < handlers; ++i)
+            mgr.registerHandlerForTags(LogLevel::TRACE, countingSink, &delivered, tags, 1);
+
+        runner.run(name, [&](uint64_t n)
+                   {
+            for (uint64_t i = 0; i < n; ++i)
+                logger.log(LogLevel::INFO, &tag, "steady state message", 1); });
+        doNotOptimize(delivered);
+    }
+
+    /// Benchmarks Logger::logf with one handler and the given format.
+    template <typename... Args>
+    void benchLogf(BenchRunner &runner, const char *name, const char *fmt, Args... args)
+    {
+        Tag tag("FMT");
+        HandlerManager mgr;
+        Logger logger(&mgr);
+        const Tag *tags[] = {&tag};
+        uint64_t delivered = 0;
+        mgr.registerHandlerForTags(LogLevel::TRACE, countingSink, &delivered, tags, 1);
+
+        runner.run(name, [&](uint64_t n)
+                   {
+            for (uint64_t i = 0; i < n; ++i)
+                logger.logf(LogLevel::INFO, &tag, fmt, args...); });
+        doNotOptimize(delivered);
+    }
+
+    /// Benchmarks a register + delete cycle on a manager with resident handlers.
+    void benchChurn(BenchRunner &runner)
+    {
+        Tag a("A"), b("B"), c("C");
+        HandlerManager mgr;
+        const Tag *tags[] = {&a, &b, &c};
+        uint64_t delivered = 0;
+        for (int i = 0; i < 4; ++i)
+            mgr.registerHandlerForTags(LogLevel::INFO, countingSink, &delivered, tags, 3);
+
+        uint16_t nextId = 5;
+        runner.run("churn/register_delete_3_tags", [&](uint64_t n)
+                   {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                mgr.registerHandlerForTags(LogLevel::WARN, countingSink, &delivered, tags, 3, "churn");
+                mgr.deleteHandlerByID(nextId++);
+                if (nextId == 0xFFFF)
+                {
+                    // IDs are 16-bit; start over before they wrap
+                    mgr.clearHandlers();
+                    for (int k = 0; k < 4; ++k)
+                        mgr.registerHandlerForTags(LogLevel::INFO, countingSink, &delivered, tags, 3);
+                    nextId = 5;
+                }
+            } });
+    }
+}
+
+int main(int argc, char **argv)
+{
+    BenchConfig cfg;
+    if (!cfg.parse(argc, argv))
+        return 2;
+    BenchRunner runner(cfg);
+
+    benchFanOut(runner, "log/no_subscribers", 0);
+    benchFanOut(runner, "log/1_handler", 1);
+    benchFanOut(runner, "log/4_handlers", 4);
+    benchFanOut(runner, "log/16_handlers", 16);
+
+    benchLogf(runner, "logf/literal", "boot complete");
+    benchLogf(runner, "logf/int", "rssi=%d", -67);
+    benchLogf(runner, "logf/string", "peer %s joined", "node-17");
+    benchLogf(runner, "logf/double", "temp=%.2f", 21.375);
+    benchLogf(runner, "logf/mixed", "%s: %d/%u bytes in %.1f ms (%x)", "ota", 4096, 65536u, 12.5, 0xBEEFu);
+
+    benchChurn(runner);
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file bench_scaling.cpp
+ * @brief Multi-producer throughput and scaling benchmark.
+ *
+ * Build target: loganywhere_scaling.  For every dispatch mode and every
+ * producer count (1, 2, 4, ... up to --threads, default = core count) it
+ * runs the producers for --duration ms and emits one CSV row:
+ *
+ *   mode,threads,msgs_per_sec,msgs_per_sec_per_thread,p50_ns,p99_ns,p999_ns,max_ns,dropped
+ *
+ * Per-call latency is sampled on every 64th call so the clock reads do not
+ * dominate the measurement.  Modes are listed in modes[]; asynchronous
+ * backends plug in with their own start / log / stop functions and report
+ * the messages they had to drop.
+ */
+
+#include "../include/LogAnywhere.h"
+#include "../include/LatencyHistogram.h"
+#include "BenchHarness.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+using namespace LogAnywhereBench;
+
+namespace
+{
+    Tag TAG_BENCH("BENCH");
+
+    /// Handler cost model: a thread-local counter, no shared writes.
+    void localCountSink(const LogMessage &msg, void *)
+    {
+        thread_local uint64_t seen = 0;
+        ++seen;
+        doNotOptimize(msg.message);
+    }
+
+    /**
+     * @brief One way of getting a message from a producer to the handlers.
+     */
+    struct ScalingMode
+    {
+        const char *name;
+        /// Prepares the backend for @p producers threads.
+        void (*start)(unsigned producers);
+        /// Logs one message from a producer thread.
+        void (*log)(const char *message);
+        /// Drains/stops the backend; returns messages dropped since start.
+        uint64_t (*stop)();
+    };
+
+    //=== Fast: synchronous dispatch on the calling thread ===//
+
+    HandlerManager fastManager;
+    Logger fastLogger(&fastManager);
+
+    /// Per-thread sequence so producers do not share Logger's fallback counter.
+    uint64_t threadSequence()
+    {
+        thread_local uint64_t sequence = 0;
+        return ++sequence;
+    }
+
+    void fastStart(unsigned) { fastLogger.setTimestampProvider(threadSequence); }
+    void fastLog(const char *message) { fastLogger.log(LogLevel::INFO, &TAG_BENCH, message); }
+    uint64_t fastStop() { return 0; }
+
+    const ScalingMode modes[] = {
+        {"fast", fastStart, fastLog, fastStop},
+    };
+
+    /**
+     * @brief Totals gathered from one run.
+     */
+    struct RunResult
+    {
+        uint64_t messages;
+        double seconds;
+        LatencyHistogram latency;
+        uint64_t dropped;
+    };
+
+    void runProducers(const ScalingMode &mode, unsigned producers, double durationMs, RunResult &out)
+    {
+        std::atomic<unsigned> ready{0};
+        std::atomic<bool> go{false}, stop{false};
+        std::atomic<uint64_t> total{0};
+
+        mode.start(producers);
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < producers; ++t)
+        {
+            threads.emplace_back([&]
+                                 {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                uint64_t n = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    for (int i = 0; i < 64; ++i)
+                        mode.log("scaling benchmark payload");
+                    uint64_t t0 = nowNs();
+                    mode.log("scaling benchmark payload");
+                    out.latency.record(nowNs() - t0);
+                    n += 65;
+                }
+                total.fetch_add(n); });
+        }
+
+        while (ready.load() < producers)
+            std::this_thread::yield();
+        uint64_t t0 = nowNs();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long>(durationMs * 1000)));
+        stop.store(true);
+        for (auto &th : threads)
+            th.join();
+        out.seconds = static_cast<double>(nowNs() - t0) / 1e9;
+        out.dropped = mode.stop();
+        out.messages = total.load();
+    }
+
+    void usage(const char *argv0)
+    {
+        std::fprintf(stderr, "usage: %s [--threads N] [--duration MS] [--handlers H] [--mode NAME] [--quick]\n", argv0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double durationMs = 500.0;
+    int handlers = 1;
+    const char *onlyMode = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+            maxThreads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (!std::strcmp(argv[i], "--duration") && i + 1 < argc)
+            durationMs = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--handlers") && i + 1 < argc)
+            handlers = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--mode") && i + 1 < argc)
+            onlyMode = argv[++i];
+        else if (!std::strcmp(argv[i], "--quick"))
+        {
+            durationMs = 20.0;
+            maxThreads = std::min(maxThreads, 2u);
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const Tag *tags[] = {&TAG_BENCH};
+    for (int h = 0; h < handlers; ++h)
+        fastManager.registerHandlerForTags(LogLevel::TRACE, localCountSink, nullptr, tags, 1);
+
+    std::printf("mode,threads,msgs_per_sec,msgs_per_sec_per_thread,p50_ns,p99_ns,p999_ns,max_ns,dropped\n");
+    for (const ScalingMode &mode : modes)
+    {
+        if (onlyMode && std::strcmp(onlyMode, mode.name) != 0)
+            continue;
+
+        std::vector<unsigned> counts;
+        for (unsigned n = 1; n < maxThreads; n *= 2)
+            counts.push_back(n);
+        counts.push_back(maxThreads);
+
+        for (unsigned producers : counts)
+        {
+            RunResult r;
+            runProducers(mode, producers, durationMs, r);
+            double rate = static_cast<double>(r.messages) / r.seconds;
+            std::printf("%s,%u,%.0f,%.0f,%llu,%llu,%llu,%llu,%llu\n", mode.name, producers, rate, rate / producers,
+                        static_cast<unsigned long long>(r.latency.p50()),
+                        static_cast<unsigned long long>(r.latency.p99()),
+                        static_cast<unsigned long long>(r.latency.p999()),
+                        static_cast<unsigned long long>(r.latency.max()),
+                        static_cast<unsigned long long>(r.dropped));
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * @file ByteSink.h
+ * @brief Defines the byte-oriented sink callback used by transport stages.
+ *
+ * A ByteSink is the raw-bytes counterpart of LogHandler: stages such as the
+ * LZ compressor accept a ByteSink plus context pointer and forward their
+ * output to it, so stages can be chained in front of any serial, file or
+ * radio writer.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Signature of a byte-oriented output callback.
+     *
+     * @param data    Pointer to the bytes to write.
+     * @param len     Number of bytes in @p data.
+     * @param context User-supplied pointer passed through registration.
+     */
+    using ByteSink = void (*)(const uint8_t *data, size_t len, void *context);
+
+} // namespace LogAnywhere
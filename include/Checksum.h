@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file Checksum.h
+ * @brief CRC32C (Castagnoli) checksum used by persistent record formats.
+ *
+ * Uses the CPU's CRC32C instruction when available (SSE4.2 on x86-64,
+ * detected at runtime; the ARMv8 CRC extension, detected at compile time)
+ * and otherwise falls back to a byte-wise table generated at compile time.
+ * All paths produce identical values.  Safe to call from signal handlers.
+ *
+ * Define LOGANYWHERE_CRC32C_SOFTWARE_ONLY to force the table path.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(LOGANYWHERE_CRC32C_SOFTWARE_ONLY)
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define LOGANYWHERE_CRC32C_X86 1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define LOGANYWHERE_CRC32C_ARM 1
+#endif
+#endif
+
+namespace LogAnywhere
+{
+
+    namespace detail
+    {
+        /// Reflected CRC32C polynomial.
+        static constexpr uint32_t CRC32C_POLY = 0x82F63B78u;
+
+        /// Byte-wise CRC32C lookup table, built by the compiler.
+        struct Crc32cTable
+        {
+            uint32_t entries[256];
+
+            constexpr Crc32cTable() : entries()
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    uint32_t c = i;
+                    for (int k = 0; k < 8; ++k)
+                        c = (c & 1u) ? (c >> 1) ^ CRC32C_POLY : (c >> 1);
+                    entries[i] = c;
+                }
+            }
+        };
+
+        static constexpr Crc32cTable CRC32C_TABLE{};
+
+        /// Table-driven update of an already-inverted CRC.
+        inline uint32_t crc32cSoftware(uint32_t crc, const uint8_t *p, size_t len)
+        {
+            while (len--)
+                crc = CRC32C_TABLE.entries[(crc ^ *p++) & 0xFFu] ^ (crc >> 8);
+            return crc;
+        }
+
+#if defined(LOGANYWHERE_CRC32C_X86)
+        /// SSE4.2 update of an already-inverted CRC, 8 bytes per instruction.
+        __attribute__((target("sse4.2"))) inline uint32_t crc32cHardware(uint32_t crc, const uint8_t *p, size_t len)
+        {
+            uint64_t c = crc;
+            while (len >= 8)
+            {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                c = _mm_crc32_u64(c, v);
+                p += 8;
+                len -= 8;
+            }
+            uint32_t c32 = static_cast<uint32_t>(c);
+            while (len--)
+                c32 = _mm_crc32_u8(c32, *p++);
+            return c32;
+        }
+
+        /// @return true if this CPU implements SSE4.2 (probed once, signal-safe).
+        inline bool crc32cHardwareAvailable()
+        {
+            static std::atomic<int> state{0}; // 0 = unknown, 1 = no, 2 = yes
+            int s = state.load(std::memory_order_relaxed);
+            if (s == 0)
+            {
+                s = __builtin_cpu_supports("sse4.2") ? 2 : 1;
+                state.store(s, std::memory_order_relaxed);
+            }
+            return s == 2;
+        }
+#elif defined(LOGANYWHERE_CRC32C_ARM)
+        /// ARMv8 CRC extension update of an already-inverted CRC.
+        inline uint32_t crc32cHardware(uint32_t crc, const uint8_t *p, size_t len)
+        {
+            while (len >= 8)
+            {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                crc = __crc32cd(crc, v);
+                p += 8;
+                len -= 8;
+            }
+            while (len--)
+                crc = __crc32cb(crc, *p++);
+            return crc;
+        }
+
+        inline bool crc32cHardwareAvailable() { return true; }
+#else
+        inline bool crc32cHardwareAvailable() { return false; }
+#endif
+    } // namespace detail
+
+    /**
+     * @brief Extends a running CRC32C over another span of bytes.
+     *
+     * Start with crc = 0; feeding a buffer in pieces yields the same value
+     * as feeding it in one call.
+     *
+     * @param crc   Value returned by a previous call (0 to start).
+     * @param data  Bytes to checksum.
+     * @param len   Number of bytes.
+     * @return Updated CRC32C.
+     */
+    inline uint32_t crc32c(uint32_t crc, const void *data, size_t len)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+#if defined(LOGANYWHERE_CRC32C_X86) || defined(LOGANYWHERE_CRC32C_ARM)
+        if (detail::crc32cHardwareAvailable())
+            return ~detail::crc32cHardware(~crc, p, len);
+#endif
+        return ~detail::crc32cSoftware(~crc, p, len);
+    }
+
+} // namespace LogAnywhere
@@ -0,0 +1,518 @@
+#pragma once
+
+/**
+ * @file Compression.h
+ * @brief Dependency-free streaming LZ compressor stage for byte-oriented sinks.
+ *
+ * LzCompressor buffers bytes up to a configurable flush threshold, compresses
+ * each block with an LZ4-block-compatible encoder and forwards it to a
+ * ByteSink as one frame.  All working memory (input block, hash table and
+ * output frame) lives inside the object, so no allocation ever happens.
+ *
+ * Frame layout (identical to the data-block layout of the LZ4 frame format):
+ *  - 4-byte little-endian header: bit 31 set ⇒ payload stored uncompressed,
+ *    bits 0..30 = payload length in bytes
+ *  - payload: one LZ4 block, or the raw bytes when compression did not help
+ *
+ * LzDecompressor is the streaming inverse, used by tests and decoders.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "ByteSink.h"
+
+/// Maximum uncompressed bytes per frame; also the largest flush threshold.
+#ifndef LOGANYWHERE_LZ_BLOCK_SIZE
+#define LOGANYWHERE_LZ_BLOCK_SIZE 2048
+#endif
+
+/// log2 of the match-finder hash table size (entries are 2 bytes each).
+#ifndef LOGANYWHERE_LZ_HASH_BITS
+#define LOGANYWHERE_LZ_HASH_BITS 10
+#endif
+
+namespace LogAnywhere
+{
+
+    /// Size of the little-endian frame header preceding every block.
+    static constexpr size_t LZ_FRAME_HEADER_SIZE = 4;
+
+    /// Header bit marking a frame whose payload is stored uncompressed.
+    static constexpr uint32_t LZ_FRAME_STORED = 0x80000000u;
+
+    /**
+     * @brief Worst-case size of an LZ4 block produced from @p srcLen bytes.
+     */
+    constexpr size_t lzCompressBound(size_t srcLen)
+    {
+        return srcLen + srcLen / 255 + 16;
+    }
+
+    namespace detail
+    {
+        static constexpr size_t LZ_MIN_MATCH = 4;     ///< Shortest encodable match
+        static constexpr size_t LZ_LAST_LITERALS = 5; ///< Block must end with literals
+        static constexpr size_t LZ_MF_LIMIT = 12;     ///< No match may start after end - 12
+        static constexpr size_t LZ_MAX_OFFSET = 65535;
+
+        inline uint32_t lzRead32(const uint8_t *p)
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint32_t lzHash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - LOGANYWHERE_LZ_HASH_BITS);
+        }
+
+        /// Writes an LZ4 length continuation (runs of 255 plus remainder).
+        inline uint8_t *lzWriteLength(uint8_t *op, size_t len)
+        {
+            while (len >= 255)
+            {
+                *op++ = 255;
+                len -= 255;
+            }
+            *op++ = static_cast<uint8_t>(len);
+            return op;
+        }
+
+        /// Reads an LZ4 length continuation; returns false on truncated input.
+        inline bool lzReadLength(const uint8_t *&ip, const uint8_t *iend, size_t &len)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend)
+                    return false;
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+            return true;
+        }
+
+        /// Emits one sequence: literals [anchor, anchor+litLen) then an optional match.
+        inline uint8_t *lzWriteSequence(uint8_t *op,
+                                        const uint8_t *anchor,
+                                        size_t litLen,
+                                        size_t offset,
+                                        size_t matchLen)
+        {
+            uint8_t *token = op++;
+            *token = static_cast<uint8_t>((litLen >= 15 ? 15 : litLen) << 4);
+            if (litLen >= 15)
+                op = lzWriteLength(op, litLen - 15);
+            std::memcpy(op, anchor, litLen);
+            op += litLen;
+
+            if (matchLen == 0)
+                return op; // final literal-only sequence
+
+            *op++ = static_cast<uint8_t>(offset & 0xFF);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            size_t ml = matchLen - LZ_MIN_MATCH;
+            *token |= static_cast<uint8_t>(ml >= 15 ? 15 : ml);
+            if (ml >= 15)
+                op = lzWriteLength(op, ml - 15);
+            return op;
+        }
+
+        inline void lzPutHeader(uint8_t *dst, uint32_t header)
+        {
+            dst[0] = static_cast<uint8_t>(header);
+            dst[1] = static_cast<uint8_t>(header >> 8);
+            dst[2] = static_cast<uint8_t>(header >> 16);
+            dst[3] = static_cast<uint8_t>(header >> 24);
+        }
+
+        inline uint32_t lzGetHeader(const uint8_t *src)
+        {
+            return static_cast<uint32_t>(src[0]) |
+                   (static_cast<uint32_t>(src[1]) << 8) |
+                   (static_cast<uint32_t>(src[2]) << 16) |
+                   (static_cast<uint32_t>(src[3]) << 24);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Compresses one independent block into LZ4 block format.
+     *
+     * Greedy single-probe match finder over a caller-provided hash table of
+     * 2^LOGANYWHERE_LZ_HASH_BITS entries; blocks must not exceed 64 KiB.
+     *
+     * @param src     Input bytes.
+     * @param srcLen  Number of input bytes (≤ 65535).
+     * @param dst     Output buffer.
+     * @param dstCap  Capacity of @p dst; lzCompressBound(srcLen) always suffices.
+     * @param table   Scratch hash table of 1 << LOGANYWHERE_LZ_HASH_BITS entries.
+     * @return Compressed size, or 0 if @p dst is too small.
+     */
+    inline size_t lzCompressBlock(const uint8_t *src,
+                                  size_t srcLen,
+                                  uint8_t *dst,
+                                  size_t dstCap,
+                                  uint16_t *table)
+    {
+        using namespace detail;
+        if (dstCap < lzCompressBound(srcLen))
+            return 0;
+
+        std::memset(table, 0, sizeof(uint16_t) << LOGANYWHERE_LZ_HASH_BITS);
+        uint8_t *op = dst;
+        size_t anchor = 0;
+
+        if (srcLen > LZ_MF_LIMIT)
+        {
+            const size_t mfLimit = srcLen - LZ_MF_LIMIT;
+            const size_t matchLimit = srcLen - LZ_LAST_LITERALS;
+            size_t ip = 1;
+            table[lzHash(lzRead32(src))] = 0;
+
+            while (ip <= mfLimit)
+            {
+                uint32_t seq = lzRead32(src + ip);
+                uint32_t h = lzHash(seq);
+                size_t ref = table[h];
+                table[h] = static_cast<uint16_t>(ip);
+
+                if (ref >= ip || ip - ref > LZ_MAX_OFFSET || lzRead32(src + ref) != seq)
+                {
+                    // Skip faster through incompressible stretches
+                    ip += 1 + ((ip - anchor) >> 6);
+                    continue;
+                }
+
+                // Extend backwards into pending literals, then forwards
+                while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+                {
+                    --ip;
+                    --ref;
+                }
+                size_t len = LZ_MIN_MATCH;
+                while (ip + len < matchLimit && src[ip + len] == src[ref + len])
+                    ++len;
+
+                op = lzWriteSequence(op, src + anchor, ip - anchor, ip - ref, len);
+                ip += len;
+                anchor = ip;
+                if (ip <= mfLimit)
+                    table[lzHash(lzRead32(src + ip - 2))] = static_cast<uint16_t>(ip - 2);
+            }
+        }
+
+        op = detail::lzWriteSequence(op, src + anchor, srcLen - anchor, 0, 0);
+        return static_cast<size_t>(op - dst);
+    }
+
+    /**
+     * @brief Decompresses one LZ4 block with full bounds checking.
+     *
+     * @param src     Compressed block.
+     * @param srcLen  Size of the compressed block.
+     * @param dst     Output buffer.
+     * @param dstCap  Capacity of @p dst.
+     * @return Decompressed size, or -1 if the block is malformed or too large.
+     */
+    inline long lzDecompressBlock(const uint8_t *src,
+                                  size_t srcLen,
+                                  uint8_t *dst,
+                                  size_t dstCap)
+    {
+        using namespace detail;
+        const uint8_t *ip = src;
+        const uint8_t *iend = src + srcLen;
+        size_t out = 0;
+
+        while (ip < iend)
+        {
+            uint8_t token = *ip++;
+            size_t litLen = token >> 4;
+            if (litLen == 15 && !lzReadLength(ip, iend, litLen))
+                return -1;
+            if (litLen > static_cast<size_t>(iend - ip) || litLen > dstCap - out)
+                return -1;
+            std::memcpy(dst + out, ip, litLen);
+            ip += litLen;
+            out += litLen;
+
+            if (ip == iend)
+                break; // last sequence carries literals only
+
+            if (iend - ip < 2)
+                return -1;
+            size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > out)
+                return -1;
+
+            size_t matchLen = token & 0x0F;
+            if (matchLen == 15 && !lzReadLength(ip, iend, matchLen))
+                return -1;
+            matchLen += LZ_MIN_MATCH;
+            if (matchLen > dstCap - out)
+                return -1;
+
+            // Byte-wise copy: source and destination may overlap
+            const uint8_t *match = dst + out - offset;
+            for (size_t i = 0; i < matchLen; ++i)
+                dst[out + i] = match[i];
+            out += matchLen;
+        }
+        return static_cast<long>(out);
+    }
+
+    /**
+     * @brief Streaming compressor stage in front of a ByteSink.
+     *
+     * Bytes passed to write() are buffered until the flush threshold is
+     * reached, then compressed and emitted as exactly one frame.  Lower
+     * thresholds bound latency and RAM at the receiver; higher thresholds
+     * improve the ratio.  Not thread-safe: serialize access externally.
+     */
+    class LzCompressor
+    {
+    public:
+        static constexpr size_t BLOCK_SIZE = LOGANYWHERE_LZ_BLOCK_SIZE; ///< Max bytes per frame
+        static constexpr size_t MAX_FRAME_SIZE =
+            LZ_FRAME_HEADER_SIZE + lzCompressBound(BLOCK_SIZE); ///< Largest emitted frame
+
+        static_assert(BLOCK_SIZE > 0 && BLOCK_SIZE <= 65535,
+                      "LOGANYWHERE_LZ_BLOCK_SIZE must be in [1, 65535]");
+        static_assert(LOGANYWHERE_LZ_HASH_BITS >= 8 && LOGANYWHERE_LZ_HASH_BITS <= 16,
+                      "LOGANYWHERE_LZ_HASH_BITS must be in [8, 16]");
+
+        /**
+         * @brief Constructs a compressor stage bound to a downstream sink.
+         *
+         * @param sink            Receives each finished frame.
+         * @param context         User data passed to @p sink.
+         * @param flushThreshold  Pending bytes that trigger a frame (clamped to [1, BLOCK_SIZE]).
+         */
+        LzCompressor(ByteSink sink, void *context, size_t flushThreshold = BLOCK_SIZE)
+            : sink(sink), context(context), threshold(clampThreshold(flushThreshold)),
+              inputLen(0), totalIn(0), totalOut(0)
+        {
+        }
+
+        /**
+         * @brief Buffers bytes, emitting a frame each time the threshold is reached.
+         *
+         * @param data Bytes to compress.
+         * @param len  Number of bytes in @p data.
+         */
+        void write(const void *data, size_t len)
+        {
+            const uint8_t *p = static_cast<const uint8_t *>(data);
+            while (len > 0)
+            {
+                size_t room = threshold - inputLen;
+                size_t n = len < room ? len : room;
+                std::memcpy(input + inputLen, p, n);
+                inputLen += n;
+                p += n;
+                len -= n;
+                if (inputLen >= threshold)
+                    flush();
+            }
+        }
+
+        /**
+         * @brief Compresses and emits any pending bytes as one frame.
+         */
+        void flush()
+        {
+            if (inputLen == 0)
+                return;
+
+            size_t packed = lzCompressBlock(input, inputLen,
+                                            output + LZ_FRAME_HEADER_SIZE,
+                                            sizeof(output) - LZ_FRAME_HEADER_SIZE,
+                                            hashTable);
+            uint32_t header;
+            if (packed == 0 || packed >= inputLen)
+            {
+                std::memcpy(output + LZ_FRAME_HEADER_SIZE, input, inputLen);
+                packed = inputLen;
+                header = static_cast<uint32_t>(packed) | LZ_FRAME_STORED;
+            }
+            else
+            {
+                header = static_cast<uint32_t>(packed);
+            }
+            detail::lzPutHeader(output, header);
+
+            size_t frameLen = LZ_FRAME_HEADER_SIZE + packed;
+            totalIn += inputLen;
+            totalOut += frameLen;
+            inputLen = 0;
+            if (sink)
+                sink(output, frameLen, context);
+        }
+
+        /**
+         * @brief Changes the flush granularity; flushes first if already exceeded.
+         * @param flushThreshold Pending bytes that trigger a frame.
+         */
+        void setFlushThreshold(size_t flushThreshold)
+        {
+            threshold = clampThreshold(flushThreshold);
+            if (inputLen >= threshold)
+                flush();
+        }
+
+        /// @return Current flush threshold in bytes.
+        size_t flushThreshold() const noexcept { return threshold; }
+
+        /// @return Bytes buffered but not yet emitted.
+        size_t pending() const noexcept { return inputLen; }
+
+        /// @return Total uncompressed bytes emitted so far.
+        uint64_t bytesIn() const noexcept { return totalIn; }
+
+        /// @return Total framed bytes (headers included) emitted so far.
+        uint64_t bytesOut() const noexcept { return totalOut; }
+
+        /**
+         * @brief ByteSink adapter so a compressor can sit behind another stage.
+         *
+         * @param data    Bytes to compress.
+         * @param len     Number of bytes.
+         * @param context Pointer to the LzCompressor.
+         */
+        static void sinkAdapter(const uint8_t *data, size_t len, void *context)
+        {
+            static_cast<LzCompressor *>(context)->write(data, len);
+        }
+
+    private:
+        ByteSink sink;    ///< Downstream frame consumer
+        void *context;    ///< User data for sink
+        size_t threshold; ///< Pending bytes that trigger flush()
+        size_t inputLen;  ///< Valid bytes in input[]
+        uint64_t totalIn;
+        uint64_t totalOut;
+
+        uint8_t input[BLOCK_SIZE];                         ///< Pending uncompressed bytes
+        uint16_t hashTable[1u << LOGANYWHERE_LZ_HASH_BITS]; ///< Match-finder state
+        uint8_t output[MAX_FRAME_SIZE];                    ///< Header + compressed block
+
+        static size_t clampThreshold(size_t t)
+        {
+            return t == 0 ? 1 : (t > BLOCK_SIZE ? BLOCK_SIZE : t);
+        }
+    };
+
+    /**
+     * @brief Streaming decoder for LzCompressor frames.
+     *
+     * Accepts the framed byte stream in arbitrary chunks and forwards each
+     * decoded block to a ByteSink.  After a malformed frame the decoder stays
+     * in the error state until reset().
+     */
+    class LzDecompressor
+    {
+    public:
+        static constexpr size_t BLOCK_SIZE = LzCompressor::BLOCK_SIZE;
+
+        /**
+         * @param sink    Receives each decoded block.
+         * @param context User data passed to @p sink.
+         */
+        LzDecompressor(ByteSink sink, void *context)
+            : sink(sink), context(context), have(0), need(LZ_FRAME_HEADER_SIZE),
+              header(0), inPayload(false), failed(false)
+        {
+        }
+
+        /**
+         * @brief Feeds framed bytes; decodes every frame completed by them.
+         *
+         * @param data Framed bytes.
+         * @param len  Number of bytes.
+         * @return false once a malformed frame has been seen.
+         */
+        bool feed(const void *data, size_t len)
+        {
+            const uint8_t *p = static_cast<const uint8_t *>(data);
+            while (len > 0 && !failed)
+            {
+                size_t n = need - have;
+                if (n > len)
+                    n = len;
+                std::memcpy(frame + have, p, n);
+                have += n;
+                p += n;
+                len -= n;
+                if (have == need)
+                    advance();
+            }
+            return !failed;
+        }
+
+        /// @return true if the stream has been malformed.
+        bool hasError() const noexcept { return failed; }
+
+        /// @brief Discards partial state and clears the error flag.
+        void reset() noexcept
+        {
+            have = 0;
+            need = LZ_FRAME_HEADER_SIZE;
+            inPayload = false;
+            failed = false;
+        }
+
+    private:
+        ByteSink sink;
+        void *context;
+        size_t have;     ///< Bytes collected for the current stage
+        size_t need;     ///< Bytes required to finish the current stage
+        uint32_t header; ///< Header of the frame being collected
+        bool inPayload;  ///< false while collecting a header
+        bool failed;
+
+        uint8_t frame[LzCompressor::MAX_FRAME_SIZE]; ///< Header, then payload
+        uint8_t block[BLOCK_SIZE];                   ///< Decoded output
+
+        void advance()
+        {
+            if (!inPayload)
+            {
+                header = detail::lzGetHeader(frame);
+                size_t payload = header & ~LZ_FRAME_STORED;
+                size_t limit = (header & LZ_FRAME_STORED) ? BLOCK_SIZE : lzCompressBound(BLOCK_SIZE);
+                if (payload == 0 || payload > limit)
+                {
+                    failed = true;
+                    return;
+                }
+                have = 0;
+                need = payload;
+                inPayload = true;
+                return;
+            }
+
+            const uint8_t *out = frame;
+            size_t outLen = need;
+            if (!(header & LZ_FRAME_STORED))
+            {
+                long n = lzDecompressBlock(frame, need, block, sizeof(block));
+                if (n < 0)
+                {
+                    failed = true;
+                    return;
+                }
+                out = block;
+                outLen = static_cast<size_t>(n);
+            }
+            if (sink)
+                sink(out, outLen, context);
+            have = 0;
+            need = LZ_FRAME_HEADER_SIZE;
+            inPayload = false;
+        }
+    };
+
+} // namespace LogAnywhere
@@ -0,0 +1,386 @@
+#pragma once
+
+/**
+ * @file CrashHandler.h
+ * @brief Opt-in, async-signal-safe emergency flush on fatal signals.
+ *
+ * installCrashHandler() hooks SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT.
+ * When one fires, the handler:
+ *  1) arms alarm() so a wedged flush can never keep the process alive,
+ *  2) writes a crash record (signal, fault address, pid) to the crash fd,
+ *  3) runs every registered CrashFlushFn in registration order, and
+ *  4) restores the default action and re-raises, so cores and exit codes
+ *     are exactly what they would have been.
+ *
+ * If another thread faults while a flush is running it parks in pause()
+ * until the first thread's re-raise (or the alarm) ends the process; only
+ * a fault from the flushing thread itself re-raises immediately.
+ *
+ * Everything on that path uses raw write(), fixed static storage and
+ * lock-free atomics: no malloc, no stdio, no locks.  Flush callbacks must
+ * obey the same rules.
+ *
+ * Only available on POSIX targets.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <signal.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "ByteSink.h"
+#include "Compression.h"
+#include "PersistentRing.h"
+
+/// Maximum number of crash flush callbacks.
+#ifndef LOGANYWHERE_MAX_CRASH_FLUSHERS
+#define LOGANYWHERE_MAX_CRASH_FLUSHERS 8
+#endif
+
+/// Size of the static alternate signal stack (lets stack overflows be reported).
+#ifndef LOGANYWHERE_CRASH_ALT_STACK_SIZE
+#define LOGANYWHERE_CRASH_ALT_STACK_SIZE 32768
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Details of the fatal signal, passed to every flush callback.
+     */
+    struct CrashInfo
+    {
+        int signal;          ///< Signal number
+        const void *address; ///< Faulting address from siginfo (may be null)
+        const char *record;  ///< Null-terminated crash record (no trailing newline)
+        size_t recordLen;    ///< Length of @c record
+        int fd;              ///< Crash descriptor given to installCrashHandler()
+    };
+
+    /**
+     * @brief Signature of a crash flush callback.
+     *
+     * Runs inside the signal handler: only async-signal-safe calls allowed.
+     *
+     * @param info    Signal details and the crash record.
+     * @param context User-supplied pointer passed to registerCrashFlush().
+     */
+    using CrashFlushFn = void (*)(const CrashInfo &info, void *context);
+
+    namespace detail
+    {
+        static constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+        static constexpr size_t CRASH_SIGNAL_COUNT = sizeof(CRASH_SIGNALS) / sizeof(CRASH_SIGNALS[0]);
+
+        /// One registered flush callback slot.
+        struct CrashFlusher
+        {
+            std::atomic<bool> claimed;     ///< Slot owned by a registration
+            std::atomic<CrashFlushFn> fn;  ///< Published last; null = skip
+            std::atomic<void *> context;
+        };
+
+        /// All crash-handler state lives in static storage.
+        struct CrashState
+        {
+            CrashFlusher flushers[LOGANYWHERE_MAX_CRASH_FLUSHERS];
+            struct sigaction previous[CRASH_SIGNAL_COUNT];
+            std::atomic<int> fd{-1};
+            std::atomic<unsigned> timeoutSeconds{2};
+            std::atomic<bool> installed{false};
+            std::atomic<long> handlingThread{0}; ///< Thread running the flush, 0 = none
+            alignas(16) uint8_t altStack[LOGANYWHERE_CRASH_ALT_STACK_SIZE];
+        };
+
+        inline CrashState &crashState()
+        {
+            static CrashState state;
+            return state;
+        }
+
+        /// Writes all of @p len bytes, retrying on EINTR and short writes.
+        inline void writeFully(int fd, const void *data, size_t len)
+        {
+            const uint8_t *p = static_cast<const uint8_t *>(data);
+            while (len > 0 && fd >= 0)
+            {
+                ssize_t n = ::write(fd, p, len);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return;
+                p += n;
+                len -= static_cast<size_t>(n);
+            }
+        }
+
+        /// Appends @p v in @p base to @p out; returns the new end.
+        inline char *appendNumber(char *out, uint64_t v, unsigned base)
+        {
+            char tmp[20];
+            size_t n = 0;
+            do
+            {
+                tmp[n++] = "0123456789abcdef"[v % base];
+                v /= base;
+            } while (v != 0);
+            while (n > 0)
+                *out++ = tmp[--n];
+            return out;
+        }
+
+        inline char *appendText(char *out, const char *text)
+        {
+            while (*text)
+                *out++ = *text++;
+            return out;
+        }
+
+        inline const char *signalName(int sig)
+        {
+            switch (sig)
+            {
+            case SIGSEGV: return "SIGSEGV";
+            case SIGBUS:  return "SIGBUS";
+            case SIGFPE:  return "SIGFPE";
+            case SIGILL:  return "SIGILL";
+            case SIGABRT: return "SIGABRT";
+            default:      return "SIGNAL";
+            }
+        }
+
+        /**
+         * @brief Formats "FATAL signal 11 (SIGSEGV) addr=0x0 pid=42" into @p out.
+         * @return Length written (buffer must hold 96 bytes).
+         */
+        inline size_t formatCrashRecord(char *out, int sig, const void *addr)
+        {
+            char *p = out;
+            p = appendText(p, "FATAL signal ");
+            p = appendNumber(p, static_cast<uint64_t>(sig), 10);
+            p = appendText(p, " (");
+            p = appendText(p, signalName(sig));
+            p = appendText(p, ") addr=0x");
+            p = appendNumber(p, reinterpret_cast<uintptr_t>(addr), 16);
+            p = appendText(p, " pid=");
+            p = appendNumber(p, static_cast<uint64_t>(getpid()), 10);
+            return static_cast<size_t>(p - out);
+        }
+
+        inline void resetToDefault(int sig)
+        {
+            struct sigaction dfl;
+            std::memset(&dfl, 0, sizeof(dfl));
+            dfl.sa_handler = SIG_DFL;
+            sigemptyset(&dfl.sa_mask);
+            sigaction(sig, &dfl, nullptr);
+        }
+
+        /// Async-signal-safe identifier of the calling thread (never 0).
+        inline long currentThreadId()
+        {
+#if defined(__linux__)
+            return static_cast<long>(syscall(SYS_gettid));
+#else
+            return static_cast<long>(reinterpret_cast<uintptr_t>(pthread_self()) | 1);
+#endif
+        }
+
+        inline void crashSignalHandler(int sig, siginfo_t *info, void *)
+        {
+            CrashState &st = crashState();
+            resetToDefault(sig);
+
+            long self = currentThreadId();
+            long owner = 0;
+            if (!st.handlingThread.compare_exchange_strong(owner, self))
+            {
+                // A fault inside a flusher must not recurse: die with the original action
+                if (owner == self)
+                {
+                    raise(sig);
+                    return;
+                }
+                // Another thread is flushing; it re-raises its own signal when
+                // done, and the alarm it armed bounds the wait.
+                for (;;)
+                    pause();
+            }
+
+            // Bound the whole flush; SIGALRM's default action terminates
+            resetToDefault(SIGALRM);
+            alarm(st.timeoutSeconds.load(std::memory_order_relaxed));
+
+            char record[96];
+            size_t len = formatCrashRecord(record, sig, info ? info->si_addr : nullptr);
+            record[len] = '\0';
+            int fd = st.fd.load(std::memory_order_relaxed);
+
+            char line[100];
+            line[0] = '\n';
+            std::memcpy(line + 1, record, len);
+            line[len + 1] = '\n';
+            writeFully(fd, line, len + 2);
+
+            CrashInfo ci{sig, info ? info->si_addr : nullptr, record, len, fd};
+            for (auto &f : st.flushers)
+            {
+                CrashFlushFn fn = f.fn.load(std::memory_order_acquire);
+                if (fn)
+                    fn(ci, f.context.load(std::memory_order_relaxed));
+            }
+
+            raise(sig);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Installs the fatal-signal handler for the whole process.
+     *
+     * The alternate signal stack is installed for the calling thread only;
+     * other threads still get the flush, but a stack overflow on them
+     * cannot be reported.
+     *
+     * @param fd              Descriptor that receives the crash record (-1 for none).
+     * @param timeoutSeconds  Upper bound on time spent flushing (≥ 1).
+     * @return true if every signal was hooked.
+     */
+    inline bool installCrashHandler(int fd, unsigned timeoutSeconds = 2)
+    {
+        auto &st = detail::crashState();
+        st.fd.store(fd, std::memory_order_relaxed);
+        st.timeoutSeconds.store(timeoutSeconds ? timeoutSeconds : 1, std::memory_order_relaxed);
+        st.handlingThread.store(0);
+        if (st.installed.load())
+            return true;
+
+        stack_t ss;
+        std::memset(&ss, 0, sizeof(ss));
+        ss.ss_sp = st.altStack;
+        ss.ss_size = sizeof(st.altStack);
+        sigaltstack(&ss, nullptr);
+
+        struct sigaction sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = detail::crashSignalHandler;
+        sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&sa.sa_mask);
+
+        bool ok = true;
+        for (size_t i = 0; i < detail::CRASH_SIGNAL_COUNT; ++i)
+            ok &= sigaction(detail::CRASH_SIGNALS[i], &sa, &st.previous[i]) == 0;
+        st.installed.store(true);
+        return ok;
+    }
+
+    /**
+     * @brief Restores the signal actions that were active before installation.
+     */
+    inline void uninstallCrashHandler()
+    {
+        auto &st = detail::crashState();
+        if (!st.installed.exchange(false))
+            return;
+        for (size_t i = 0; i < detail::CRASH_SIGNAL_COUNT; ++i)
+            sigaction(detail::CRASH_SIGNALS[i], &st.previous[i], nullptr);
+    }
+
+    /**
+     * @brief Adds a callback run by the crash handler.
+     *
+     * @param fn       Async-signal-safe flush callback.
+     * @param context  User data passed to @p fn.
+     * @return false if all LOGANYWHERE_MAX_CRASH_FLUSHERS slots are taken.
+     */
+    inline bool registerCrashFlush(CrashFlushFn fn, void *context)
+    {
+        for (auto &f : detail::crashState().flushers)
+        {
+            if (!f.claimed.exchange(true))
+            {
+                f.context.store(context, std::memory_order_relaxed);
+                f.fn.store(fn, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Removes a callback previously added with registerCrashFlush().
+     * @return true if a matching registration was found.
+     */
+    inline bool unregisterCrashFlush(CrashFlushFn fn, void *context)
+    {
+        for (auto &f : detail::crashState().flushers)
+        {
+            if (f.fn.load() == fn && f.context.load() == context)
+            {
+                f.fn.store(nullptr, std::memory_order_release);
+                f.claimed.store(false);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //=== Async-signal-safe building blocks ===//
+
+    /**
+     * @brief ByteSink that write()s to a file descriptor.
+     *
+     * The descriptor is carried in the context pointer itself:
+     * pass fdSinkContext(fd).
+     */
+    inline void fdByteSink(const uint8_t *data, size_t len, void *context)
+    {
+        detail::writeFully(static_cast<int>(reinterpret_cast<intptr_t>(context)), data, len);
+    }
+
+    /// @return Context value for fdByteSink() writing to @p fd.
+    inline void *fdSinkContext(int fd)
+    {
+        return reinterpret_cast<void *>(static_cast<intptr_t>(fd));
+    }
+
+    /**
+     * @brief Crash flusher for an LzCompressor (context = LzCompressor*).
+     *
+     * Appends the crash record to the pending block and emits it.  The
+     * compressor's downstream sink must itself be signal-safe (e.g.
+     * fdByteSink).
+     */
+    inline void crashFlushCompressor(const CrashInfo &info, void *context)
+    {
+        auto *lz = static_cast<LzCompressor *>(context);
+        lz->write(info.record, info.recordLen);
+        lz->write("\n", 1);
+        lz->flush();
+    }
+
+    /**
+     * @brief Crash flusher for a PersistentRing (context = PersistentRing*).
+     *
+     * Appends the crash record as an ERR message tagged "CRASH".  Ring pages
+     * already live in the page cache, so no further flush is needed.
+     */
+    inline void crashFlushPersistentRing(const CrashInfo &info, void *context)
+    {
+        LogMessage msg(LogLevel::ERR, "CRASH", info.record, 0);
+        static_cast<PersistentRing *>(context)->appendMessage(msg);
+    }
+
+} // namespace LogAnywhere
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -19,6 +19,33 @@
 #define MAX_TAG_SUBSCRIPTIONS 20
 #endif
 
+/// Set to 1 to time every handler invocation into HandlerEntry::latency.
+#ifndef LOGANYWHERE_ENABLE_HANDLER_LATENCY
+#define LOGANYWHERE_ENABLE_HANDLER_LATENCY 0
+#endif
+
+#if LOGANYWHERE_ENABLE_HANDLER_LATENCY
+#include "LatencyHistogram.h"
+#endif
+
+/// Set to 1 to count routing decisions (see HandlerManager::snapshotStats()).
+#ifndef LOGANYWHERE_ENABLE_STATS
+#define LOGANYWHERE_ENABLE_STATS 0
+#endif
+
+#if LOGANYWHERE_ENABLE_STATS
+#include "RoutingStats.h"
+#endif
+
+/// Set to 1 to enable HandlerManager(const MemoryResource&) growable registries.
+#ifndef LOGANYWHERE_ENABLE_GROWABLE
+#define LOGANYWHERE_ENABLE_GROWABLE 0
+#endif
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+#include "MemoryResource.h"
+#endif
+
 namespace LogAnywhere
 {
     struct Tag;
@@ -33,6 +60,15 @@ namespace LogAnywhere
      * @param context User-supplied pointer passed through registration.
      */
     using LogHandler = void (*)(const LogMessage &msg, void *context);
+
+    /// Bit set of handler groups (bit n = group n); see HandlerManager::disableGroups().
+    using HandlerGroups = uint32_t;
+
+    /**
+     * @brief Returns the HandlerGroups bit of group @p index.
+     * @param index Group number, 0 .. 31.
+     */
+    constexpr HandlerGroups handlerGroup(unsigned index) { return HandlerGroups(1) << index; }
     /**
      * @brief Represents one registered log handler with its routing metadata.
      *
@@ -50,7 +86,24 @@ namespace LogAnywhere
         const Tag *tagList[MAX_TAG_SUBSCRIPTIONS]; ///< Fixed-size subscription list
         size_t tagCount = 0;                       ///< Actual entries in tagList[]
 
-        bool enabled = true; ///< If false, this handler is skipped
+        const char *const *patterns = nullptr; ///< Wildcard subscriptions (caller-owned), see TagPattern.h
+        size_t patternCount = 0;               ///< Entries in patterns[]
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        const Tag **extraTags = nullptr; ///< Full tag list when a growable manager stored more than tagList[] holds
+#endif
+
+        bool enabled = true; ///< If false, this handler is skipped; change it with setEnabled()
+        HandlerGroups groups = 0; ///< Groups this handler belongs to; skipped while any is disabled
+
+#if LOGANYWHERE_ENABLE_HANDLER_LATENCY
+        mutable LatencyHistogram latency; ///< Callback latency in ns, recorded by Logger
+#endif
+
+#if LOGANYWHERE_ENABLE_STATS
+        uint32_t droppedSubscriptions = 0; ///< Tags this handler could not join (tag full)
+        mutable HandlerCounters counters;  ///< Per-thread-sharded routing counters, written by Logger
+#endif
 
         /**
          * @brief Default constructor. Leaves all fields zero- or default-initialized.
@@ -99,6 +152,18 @@ namespace LogAnywhere
             tagCount = toCopy;
         }
 
+        /**
+         * @brief Returns the i-th subscribed Tag (0 .. tagCount - 1).
+         */
+        inline const Tag *tagAt(size_t i) const noexcept
+        {
+#if LOGANYWHERE_ENABLE_GROWABLE
+            if (extraTags)
+                return extraTags[i];
+#endif
+            return tagList[i];
+        }
+
         /**
          * @brief Check whether this handler is currently enabled.
          *
@@ -109,14 +174,20 @@ namespace LogAnywhere
         /**
          * @brief Enable or disable this handler.
          *
+         * Also rebuilds the dispatch lists of every Tag it is subscribed
+         * to (defined in Tag.h).
+         *
          * @param on Pass true to enable dispatch; false to skip this handler.
          */
-        inline void setEnabled(bool on) noexcept { enabled = on; }
+        void setEnabled(bool on) noexcept;
 
         /**
          * @brief Shortcut to disable this handler.
          */
-        inline void disable() noexcept { enabled = false; }
+        void disable() noexcept;
     };
 
 } // namespace LogAnywhere
+
+// Defines setEnabled() and disable(), which rebuild the Tags' dispatch lists
+#include "Tag.h"
@@ -0,0 +1,363 @@
+#pragma once
+
+/**
+ * @file HandlerExecutor.h
+ * @brief Work-stealing worker pool that runs slow handlers off the logging path.
+ *
+ * A single consumer thread runs out of CPU time when several sinks are each
+ * expensive (compression, encryption, a socket).  HandlerExecutor gives
+ * every slow handler a lane: a MessageRing of pending messages plus the
+ * handler's callback.
+ *
+ *  - Registering laneHandler() for a lane makes dispatch (synchronous, or
+ *    from an async queue's consumer) copy the message into that lane.
+ *  - A lane with pending messages is queued on its home worker.  A worker
+ *    runs up to LOGANYWHERE_EXECUTOR_BATCH messages of a lane, then
+ *    requeues it if more arrived.
+ *  - A lane is held by at most one worker at a time, so each handler sees
+ *    its messages in order and is never called concurrently with itself,
+ *    while different handlers run in parallel.
+ *  - An idle worker steals half of the lanes queued on the busiest other
+ *    worker, each lane being a batch of that handler's pending messages.
+ *
+ * @code
+ * HandlerExecutor pool;
+ * int gz = pool.addHandler(compressAndShip, &shipper);
+ * int tls = pool.addHandler(encryptAndSend, &socket);
+ * mgr.registerHandlerForTags(LogLevel::INFO, HandlerExecutor::laneHandler, pool.lane(gz), tags, n);
+ * mgr.registerHandlerForTags(LogLevel::INFO, HandlerExecutor::laneHandler, pool.lane(tls), tags, n);
+ * pool.start(4);
+ * @endcode
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "MessageRing.h"
+
+/// Largest number of worker threads.
+#ifndef LOGANYWHERE_EXECUTOR_MAX_WORKERS
+#define LOGANYWHERE_EXECUTOR_MAX_WORKERS 8
+#endif
+
+/// Largest number of handlers (lanes).
+#ifndef LOGANYWHERE_EXECUTOR_MAX_LANES
+#define LOGANYWHERE_EXECUTOR_MAX_LANES 16
+#endif
+
+/// Pending messages per lane (power of two).
+#ifndef LOGANYWHERE_EXECUTOR_LANE_SLOTS
+#define LOGANYWHERE_EXECUTOR_LANE_SLOTS 64
+#endif
+
+/// Bytes per pending message for tag and message text.
+#ifndef LOGANYWHERE_EXECUTOR_SLOT_TEXT
+#define LOGANYWHERE_EXECUTOR_SLOT_TEXT 128
+#endif
+
+/// Messages a worker runs from one lane before giving other lanes a turn.
+#ifndef LOGANYWHERE_EXECUTOR_BATCH
+#define LOGANYWHERE_EXECUTOR_BATCH 32
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Runs handler invocations on a pool of work-stealing workers.
+     */
+    class HandlerExecutor
+    {
+    public:
+        static constexpr size_t MAX_WORKERS = LOGANYWHERE_EXECUTOR_MAX_WORKERS; ///< Worker capacity
+        static constexpr size_t MAX_LANES = LOGANYWHERE_EXECUTOR_MAX_LANES;     ///< Handler capacity
+        static constexpr size_t BATCH = LOGANYWHERE_EXECUTOR_BATCH;             ///< Messages per lane turn
+
+        /**
+         * @brief Pending work of one handler.
+         */
+        class Lane
+        {
+        public:
+            /// @return Messages dropped because this lane was full.
+            uint64_t dropped() const noexcept { return ring.dropped(); }
+
+        private:
+            friend class HandlerExecutor;
+
+            MessageRing<LOGANYWHERE_EXECUTOR_LANE_SLOTS, LOGANYWHERE_EXECUTOR_SLOT_TEXT> ring;
+            HandlerExecutor *owner = nullptr;
+            LogHandler fn = nullptr;
+            void *ctx = nullptr;
+            size_t home = 0;                     ///< Worker the lane is queued on by default
+            std::atomic<bool> scheduled{false};  ///< Queued on a worker or being run
+        };
+
+        HandlerExecutor() = default;
+        ~HandlerExecutor() { stop(); }
+
+        HandlerExecutor(const HandlerExecutor &) = delete;
+        HandlerExecutor &operator=(const HandlerExecutor &) = delete;
+
+        /**
+         * @brief Adds a slow handler; call before start().
+         *
+         * @param fn  Handler to run on the pool.
+         * @param ctx Passed through to @p fn.
+         * @return The lane index, or -1 if all lanes are taken.
+         */
+        int addHandler(LogHandler fn, void *ctx)
+        {
+            if (laneCount == MAX_LANES || !fn)
+                return -1;
+            Lane &l = lanes[laneCount];
+            l.owner = this;
+            l.fn = fn;
+            l.ctx = ctx;
+            return static_cast<int>(laneCount++);
+        }
+
+        /**
+         * @brief Context to register together with laneHandler().
+         * @param index Lane index from addHandler().
+         * @return The lane, or nullptr if @p index is invalid.
+         */
+        Lane *lane(int index) noexcept
+        {
+            return index >= 0 && static_cast<size_t>(index) < laneCount ? &lanes[index] : nullptr;
+        }
+
+        /**
+         * @brief Starts @p workers threads.
+         *
+         * Lanes get home workers round-robin.
+         *
+         * @param workers Thread count, 1 .. MAX_WORKERS.
+         * @return false if already running or @p workers is out of range.
+         */
+        bool start(size_t workers)
+        {
+            if (workerCount != 0 || workers == 0 || workers > MAX_WORKERS)
+                return false;
+            stopping.store(false, std::memory_order_relaxed);
+            for (size_t i = 0; i < laneCount; ++i)
+                lanes[i].home = i % workers;
+            workerCount = workers;
+            for (size_t w = 0; w < workers; ++w)
+                threads[w] = std::thread(&HandlerExecutor::workerMain, this, w);
+            return true;
+        }
+
+        /**
+         * @brief Runs every queued message, then stops the workers.
+         *
+         * Producers must have stopped submitting.
+         */
+        void stop()
+        {
+            if (workerCount == 0)
+                return;
+            {
+                std::lock_guard<std::mutex> guard(idleLock);
+                stopping.store(true, std::memory_order_relaxed);
+            }
+            idleCv.notify_all();
+            for (size_t w = 0; w < workerCount; ++w)
+                threads[w].join();
+            workerCount = 0;
+        }
+
+        /**
+         * @brief Queues @p msg for a handler.
+         *
+         * @param lane Lane from lane().
+         * @param msg  Message to copy.
+         * @return false if the lane was full and the message was dropped.
+         */
+        bool submit(Lane &lane, const LogMessage &msg)
+        {
+            if (!lane.ring.push(msg))
+                return false;
+            // Pairs with the fence in run(): either we see the lane released or it sees our message
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            schedule(lane);
+            return true;
+        }
+
+        /// @return Lanes taken by an idle worker from another worker's queue.
+        uint64_t steals() const noexcept { return stealCount.load(std::memory_order_relaxed); }
+
+        /// @return Messages dropped because their lane was full.
+        uint64_t dropped() const noexcept
+        {
+            uint64_t total = 0;
+            for (size_t i = 0; i < laneCount; ++i)
+                total += lanes[i].dropped();
+            return total;
+        }
+
+        /**
+         * @brief LogHandler adapter: register with a Lane* (from lane()) as context.
+         */
+        static void laneHandler(const LogMessage &msg, void *context)
+        {
+            Lane *l = static_cast<Lane *>(context);
+            l->owner->submit(*l, msg);
+        }
+
+    private:
+        /// FIFO of lanes waiting for a worker; each lane is in at most one.
+        struct WorkerQueue
+        {
+            std::mutex lock;
+            Lane *lanes[MAX_LANES];
+            size_t first = 0;
+            std::atomic<size_t> count{0}; ///< Written under lock; read unlocked by thieves
+
+            void push(Lane *l)
+            {
+                const size_t n = count.load(std::memory_order_relaxed);
+                lanes[(first + n) % MAX_LANES] = l;
+                count.store(n + 1, std::memory_order_relaxed);
+            }
+
+            Lane *pop()
+            {
+                const size_t n = count.load(std::memory_order_relaxed);
+                if (n == 0)
+                    return nullptr;
+                Lane *l = lanes[first];
+                first = (first + 1) % MAX_LANES;
+                count.store(n - 1, std::memory_order_relaxed);
+                return l;
+            }
+        };
+
+        Lane lanes[MAX_LANES];
+        size_t laneCount = 0;
+        WorkerQueue queues[MAX_WORKERS];
+        std::thread threads[MAX_WORKERS];
+        size_t workerCount = 0;
+
+        std::atomic<size_t> queued{0};       ///< Lanes sitting in any WorkerQueue
+        std::atomic<bool> stopping{false};
+        std::atomic<uint64_t> stealCount{0};
+        std::mutex idleLock;                 ///< Guards sleeping on idleCv
+        std::condition_variable idleCv;
+
+        /// Queues @p lane on its home worker unless it is already queued or running.
+        void schedule(Lane &lane)
+        {
+            if (lane.scheduled.exchange(true, std::memory_order_acq_rel))
+                return;
+            enqueue(lane.home, &lane);
+        }
+
+        void enqueue(size_t worker, Lane *lane)
+        {
+            {
+                std::lock_guard<std::mutex> guard(queues[worker].lock);
+                queues[worker].push(lane);
+            }
+            queued.fetch_add(1, std::memory_order_release);
+            idleCv.notify_one();
+        }
+
+        /// @return The next lane from @p worker's own queue, or nullptr.
+        Lane *takeOwn(size_t worker)
+        {
+            Lane *l;
+            {
+                std::lock_guard<std::mutex> guard(queues[worker].lock);
+                l = queues[worker].pop();
+            }
+            if (l)
+                queued.fetch_sub(1, std::memory_order_relaxed);
+            return l;
+        }
+
+        /**
+         * @brief Moves half of the longest other queue to @p thief.
+         * @return One stolen lane to run now, or nullptr.
+         */
+        Lane *steal(size_t thief)
+        {
+            size_t victim = thief;
+            size_t longest = 0;
+            for (size_t w = 0; w < workerCount; ++w)
+            {
+                // Unlocked peek; the real count is re-read under the lock
+                const size_t n = queues[w].count.load(std::memory_order_relaxed);
+                if (w != thief && n > longest)
+                {
+                    longest = n;
+                    victim = w;
+                }
+            }
+            if (victim == thief)
+                return nullptr;
+
+            Lane *batch[MAX_LANES];
+            size_t taken = 0;
+            {
+                std::lock_guard<std::mutex> guard(queues[victim].lock);
+                const size_t want = (queues[victim].count.load(std::memory_order_relaxed) + 1) / 2;
+                while (taken < want)
+                    batch[taken++] = queues[victim].pop();
+            }
+            if (taken == 0)
+                return nullptr;
+            stealCount.fetch_add(taken, std::memory_order_relaxed);
+            if (taken > 1)
+            {
+                std::lock_guard<std::mutex> guard(queues[thief].lock);
+                for (size_t i = 1; i < taken; ++i)
+                    queues[thief].push(batch[i]);
+            }
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return batch[0];
+        }
+
+        /// Runs up to BATCH messages of @p lane, then releases or requeues it.
+        void run(size_t worker, Lane &lane)
+        {
+            for (size_t i = 0; i < BATCH && lane.ring.pop(lane.fn, lane.ctx); ++i)
+            {
+            }
+            // Once released, another worker may own the ring; only read its tail
+            const uint64_t position = lane.ring.readPosition();
+            lane.scheduled.store(false, std::memory_order_release);
+            // A submit that saw scheduled == true relies on us to pick its message up
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (lane.ring.pushedSince(position) && !lane.scheduled.exchange(true, std::memory_order_acq_rel))
+                enqueue(worker, &lane);
+        }
+
+        void workerMain(size_t worker)
+        {
+            for (;;)
+            {
+                Lane *l = takeOwn(worker);
+                if (!l)
+                    l = steal(worker);
+                if (l)
+                {
+                    run(worker, *l);
+                    continue;
+                }
+                std::unique_lock<std::mutex> guard(idleLock);
+                if (stopping.load(std::memory_order_relaxed) && queued.load(std::memory_order_acquire) == 0)
+                    return;
+                idleCv.wait_for(guard, std::chrono::milliseconds(1), [this]
+                                { return queued.load(std::memory_order_acquire) != 0 ||
+                                         stopping.load(std::memory_order_relaxed); });
+            }
+        }
+    };
+
+} // namespace LogAnywhere
@@ -7,16 +7,25 @@
  * HandlerManager stores up to LOGANYWHERE_MAX_HANDLERS HandlerEntry instances,
  * each of which may subscribe to a fixed list of Tag* pointers.  It supports:
  *  - Fast, exact‐match registration via Tag* pointers
+ *  - Wildcard registration over dotted tag names ("net.*"), resolved into
+ *    the same per-Tag subscriber lists at registration and Tag creation
  *  - Full removal (pruning from Tag subscriber lists and compacting registry)
  *  - Clearing all handlers and resetting IDs
  *  - Listing current handlers
+ *  - Handler groups, switched on and off together with one atomic store
+ *  - Optional routing statistics (LOGANYWHERE_ENABLE_STATS)
+ *  - A growable mode backed by a user MemoryResource, for servers that need
+ *    more handlers or more subscribers per Tag than the static limits allow
+ *    (compiled in with LOGANYWHERE_ENABLE_GROWABLE=1)
  *
  * Dispatching is performed by Logger, not by this class.
  */
 
 #include "HandlerEntry.h"
 #include "Tag.h"
+#include "TagPattern.h"
 #include "LogLevel.h"
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
@@ -25,8 +34,31 @@
 #define LOGANYWHERE_MAX_HANDLERS 6
 #endif
 
+#if LOGANYWHERE_ENABLE_GROWABLE
+#include <new>
+
+/// Entries per chunk allocated by a growable HandlerManager once its inline slots are used.
+#ifndef LOGANYWHERE_REGISTRY_CHUNK
+#define LOGANYWHERE_REGISTRY_CHUNK 32
+#endif
+#endif
+
 namespace LogAnywhere
 {
+    class Logger;
+    class HandlerManager;
+    class RoutingTransaction;
+
+    namespace detail
+    {
+        /// Head of the list of every live HandlerManager (linked through nextManager).
+        inline HandlerManager *liveManagers = nullptr;
+    } // namespace detail
+
+#if LOGANYWHERE_ENABLE_STATS
+    /// Routing counters of a HandlerManager, see HandlerManager::snapshotStats().
+    using RoutingStatsSnapshot = RoutingStatsSnapshotT<LOGANYWHERE_MAX_HANDLERS>;
+#endif
 
     /**
      * @brief Stores and manages all registered HandlerEntry instances.
@@ -41,8 +73,91 @@ namespace LogAnywhere
          */
         HandlerManager()
             : handlerCount(0),
-              nextHandlerId(1)
+              nextHandlerId(1),
+              nextManager(detail::liveManagers),
+              enabledGroupMask(~HandlerGroups(0))
+#if LOGANYWHERE_ENABLE_GROWABLE
+              ,
+              resource{nullptr, nullptr, nullptr},
+              inlineUsed(0),
+              chunks(nullptr),
+              chunkUsed(0),
+              freeList(nullptr),
+              directory(nullptr),
+              directoryCapacity(0)
+#endif
+        {
+            detail::liveManagers = this;
+            detail::tagCreatedHook = &HandlerManager::subscribeNewTag;
+        }
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        /**
+         * @brief Constructs an empty, growable HandlerManager.
+         *
+         * The LOGANYWHERE_MAX_HANDLERS inline slots are used first; further
+         * entries come from @p memory in chunks of LOGANYWHERE_REGISTRY_CHUNK.
+         * A live entry is never moved, so deleting a handler leaves a free
+         * slot for the next registration instead of compacting.  Tags that
+         * outgrow MAX_TAG_SUBSCRIPTIONS get their subscriber list moved to
+         * @p memory, and a handler may subscribe to more than
+         * MAX_TAG_SUBSCRIPTIONS Tags.  A grown Tag list is kept until the Tag
+         * has no subscribers left, so churn around the limit does not
+         * allocate again.
+         *
+         * Dispatch cost is the same as in static mode: Logger walks the
+         * Tag's subscriber array either way.  Growing a Tag's list frees the
+         * old array, so registration must not race with logging on that Tag
+         * (use a monotonic resource such as ArenaResource if it can).
+         *
+         * @param memory Allocator for chunks, the handler directory and grown
+         *               subscriber lists; must outlive this manager and every
+         *               Tag it grew.
+         */
+        explicit HandlerManager(const MemoryResource &memory)
+            : HandlerManager()
+        {
+            resource = memory;
+        }
+
+#endif
+
+        /**
+         * @brief Leaves the live-manager list and, in growable mode, releases
+         *        memory taken from the MemoryResource.
+         *
+         * Tags are not touched here: call clearHandlers() first if Tags
+         * outlive the manager and should stop pointing at its entries.
+         */
+        ~HandlerManager()
         {
+            for (HandlerManager **link = &detail::liveManagers; *link; link = &(*link)->nextManager)
+            {
+                if (*link == this)
+                {
+                    *link = nextManager;
+                    break;
+                }
+            }
+#if LOGANYWHERE_ENABLE_GROWABLE
+            for (size_t i = 0; directory && i < handlerCount; ++i)
+                releaseExtraTags(directory[i]);
+            releaseChunks();
+            resource.deallocateBytes(directory, directoryCapacity * sizeof(HandlerEntry *), alignof(HandlerEntry *));
+#endif
+        }
+
+        HandlerManager(const HandlerManager &) = delete;
+        HandlerManager &operator=(const HandlerManager &) = delete;
+
+        /// @return true if constructed with a MemoryResource.
+        bool isGrowable() const noexcept
+        {
+#if LOGANYWHERE_ENABLE_GROWABLE
+            return resource.allocate != nullptr;
+#else
+            return false;
+#endif
         }
 
         /**
@@ -51,30 +166,19 @@ namespace LogAnywhere
          * After this call, no handlers remain registered. New registrations
          * will begin again at ID = 1.
          *
-         * @note Tag subscriber lists are _not_ automatically cleared.
+         * @note Every handler is also pruned from the Tag subscriber lists it
+         *       joined, so no Tag is left pointing at a wiped entry.
          */
         void clearHandlers()
         {
-            // Use a temp copy so we can unsubscribe safely before the memory is wiped
+            // Unsubscribe everything before the memory is wiped
             for (size_t i = 0; i < handlerCount; ++i)
             {
-                HandlerEntry *e = &handlers[i];
-                // Make a local copy of the tag list to safely unsubscribe
-                const Tag *tags[MAX_TAG_SUBSCRIPTIONS];
-                std::memcpy(tags, e->tagList, sizeof(tags));
-                size_t tagCount = e->tagCount;
-
-                for (size_t t = 0; t < tagCount; ++t)
-                {
-                    Tag *tag = const_cast<Tag *>(tags[t]);
-                    size_t wr = 0;
-                    for (size_t rd = 0; rd < tag->handlerCount; ++rd)
-                    {
-                        if (tag->handlers[rd] != e)
-                            tag->handlers[wr++] = tag->handlers[rd];
-                    }
-                    tag->handlerCount = wr;
-                }
+                HandlerEntry *e = entryAt(i);
+                unsubscribeEntryFromTags(e);
+#if LOGANYWHERE_ENABLE_GROWABLE
+                releaseExtraTags(e);
+#endif
             }
 
             // Now safe to wipe handler state
@@ -84,19 +188,171 @@ namespace LogAnywhere
             }
             handlerCount = 0;
             nextHandlerId = 1;
+#if LOGANYWHERE_ENABLE_GROWABLE
+            releaseChunks();
+            inlineUsed = 0;
+            freeList = nullptr;
+#endif
         }
         /**
          * @brief Lists all registered handlers.
          *
          * @param outCount Populated with the number of handlers in the array.
          * @return Pointer to the internal HandlerEntry array.
+         *
+         * @note Static mode only: a growable manager has no contiguous array
+         *       and reports zero entries here; use registeredCount() and
+         *       handlerAt() instead, which work in both modes.
          */
         const HandlerEntry *listHandlers(size_t &outCount) const
         {
-            outCount = handlerCount;
+            outCount = isGrowable() ? 0 : handlerCount;
             return handlers;
         }
 
+        /// @return Number of registered handlers.
+        size_t registeredCount() const noexcept { return handlerCount; }
+
+        /**
+         * @brief Returns a handler by registration order.
+         *
+         * @param index 0 .. registeredCount() - 1.
+         * @return The entry, or nullptr if @p index is out of range.
+         */
+        const HandlerEntry *handlerAt(size_t index) const
+        {
+            return index < handlerCount ? const_cast<HandlerManager *>(this)->entryAt(index) : nullptr;
+        }
+
+        /// @copydoc handlerAt(size_t) const
+        /// Mutable so callers can enable or disable the handler in place.
+        HandlerEntry *handlerAt(size_t index)
+        {
+            return index < handlerCount ? entryAt(index) : nullptr;
+        }
+
+        /**
+         * @brief Puts a handler into groups (replacing its previous ones).
+         *
+         * A handler is dispatched only while every group it belongs to is
+         * enabled; a handler in no group is unaffected by group switches.
+         *
+         * @param id     Unique ID of the handler.
+         * @param groups Bit set, e.g. handlerGroup(0) | handlerGroup(3).
+         * @return true if the handler exists.
+         */
+        bool setHandlerGroups(uint16_t id, HandlerGroups groups)
+        {
+            HandlerEntry *e = findEntryByID(id);
+            if (!e)
+                return false;
+            e->groups = groups;
+            detail::refreshSubscriber(e);
+            return true;
+        }
+
+        /// @copydoc setHandlerGroups(uint16_t, HandlerGroups)
+        /// @param name Name of the handler.
+        bool setHandlerGroups(const char *name, HandlerGroups groups)
+        {
+            HandlerEntry *e = findEntryByName(name);
+            if (!e)
+                return false;
+            e->groups = groups;
+            detail::refreshSubscriber(e);
+            return true;
+        }
+
+        /**
+         * @brief Enables the groups in @p groups; one atomic read-modify-write.
+         * @param groups Bit set of groups to enable.
+         */
+        void enableGroups(HandlerGroups groups) noexcept
+        {
+            enabledGroupMask.fetch_or(groups, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Disables the groups in @p groups; one atomic read-modify-write.
+         *
+         * Every handler in any of them is skipped by the next dispatch,
+         * regardless of its own enabled flag.
+         *
+         * @param groups Bit set of groups to disable.
+         */
+        void disableGroups(HandlerGroups groups) noexcept
+        {
+            enabledGroupMask.fetch_and(~groups, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Replaces the whole enabled-groups mask with one store.
+         * @param groups Bit set of groups that are enabled from now on.
+         */
+        void setEnabledGroups(HandlerGroups groups) noexcept
+        {
+            enabledGroupMask.store(groups, std::memory_order_relaxed);
+        }
+
+        /// @return The enabled-groups mask (all groups are enabled initially).
+        HandlerGroups enabledGroups() const noexcept
+        {
+            return enabledGroupMask.load(std::memory_order_relaxed);
+        }
+
+#if LOGANYWHERE_ENABLE_STATS
+        /**
+         * @brief Aggregates the routing counters across all thread shards.
+         *
+         * Safe to call while other threads are logging; counters are read
+         * individually, so a snapshot taken mid-dispatch may be off by the
+         * messages in flight.
+         *
+         * @return Totals plus one HandlerStats per registered handler.
+         */
+        RoutingStatsSnapshot snapshotStats() const;
+
+        /**
+         * @brief Returns the per-level message counts of a single tag.
+         *
+         * @param tag Tag to inspect.
+         * @return Counts by level and their sum.
+         */
+        TagStatsSnapshot snapshotStats(const Tag *tag) const;
+
+        /**
+         * @brief Reads per-handler counters for any number of handlers.
+         *
+         * @param out      Destination rows.
+         * @param capacity Number of rows in @p out.
+         * @param first    Registration index to start at (for paging).
+         * @return Number of rows written.
+         */
+        size_t snapshotHandlerStats(HandlerStats *out, size_t capacity, size_t first = 0) const;
+
+        /**
+         * @brief Zeroes every routing counter of this manager.
+         *
+         * Per-tag counters are not touched; they belong to the Tags.
+         * Per-handler counters are zeroed along with the totals.
+         */
+        void resetStats();
+#endif
+
+#if LOGANYWHERE_ENABLE_HANDLER_LATENCY
+        /**
+         * @brief Returns the invocation latency histogram of a handler.
+         *
+         * @param id Unique ID of the handler.
+         * @return Pointer to its histogram, or nullptr if no such handler.
+         */
+        const LatencyHistogram *handlerLatency(uint16_t id) const
+        {
+            const HandlerEntry *e = const_cast<HandlerManager *>(this)->findEntryByID(id);
+            return e ? &e->latency : nullptr;
+        }
+#endif
+
         /**
          * @brief Registers a handler for an explicit list of Tag* subscriptions.
          *
@@ -109,7 +365,9 @@ namespace LogAnywhere
          * @param tagList   Array of Tag* that this handler subscribes to.
          * @param tagCount  Number of elements in tagList.
          * @param name      Optional handler name for diagnostics or removal.
-         * @return true if registration succeeded, false if capacity is exceeded.
+         * @return true if registration succeeded, false if capacity is exceeded
+         *         (or, in growable mode, the MemoryResource is exhausted; the
+         *         registration is then rolled back completely).
          */
         bool registerHandlerForTags(LogLevel level,
                                     LogHandler fn,
@@ -118,6 +376,32 @@ namespace LogAnywhere
                                     size_t tagCount,
                                     const char *name = nullptr);
 
+        /**
+         * @brief Registers a handler for every Tag whose dotted name matches
+         *        one of @p patterns (e.g. "net.*", see TagPattern.h).
+         *
+         * Patterns are resolved here, against every live Tag, and again
+         * whenever a Tag is constructed later, straight into the Tags'
+         * subscriber lists; dispatch never matches patterns.  Matched Tags
+         * do not count against the handler's MAX_TAG_SUBSCRIPTIONS.
+         *
+         * @param level        Minimum log level to invoke this handler.
+         * @param fn           Callback function pointer.
+         * @param ctx          User-supplied context passed to the callback.
+         * @param patterns     Wildcard patterns; the array and its strings
+         *                     must outlive the registration.
+         * @param patternCount Number of elements in @p patterns.
+         * @param name         Optional handler name for diagnostics or removal.
+         * @return true if registration succeeded, false if capacity is exceeded
+         *         (or a growable manager ran out of memory).
+         */
+        bool registerHandlerForPatterns(LogLevel level,
+                                        LogHandler fn,
+                                        void *ctx,
+                                        const char *const patterns[],
+                                        size_t patternCount,
+                                        const char *name = nullptr);
+
         /**
          * @brief Deletes a handler by its unique ID.
          *
@@ -142,9 +426,38 @@ namespace LogAnywhere
 
     private:
         static constexpr size_t MAX_HANDLERS = LOGANYWHERE_MAX_HANDLERS; ///< Capacity of handlers[]
+
         HandlerEntry handlers[MAX_HANDLERS];                             ///< Storage of all handlers
         size_t handlerCount;                                             ///< Number of active entries
         uint16_t nextHandlerId;                                          ///< Next ID to assign
+        HandlerManager *nextManager;                                     ///< Next live manager (detail::liveManagers)
+        std::atomic<HandlerGroups> enabledGroupMask;                     ///< Groups currently enabled, read by Logger
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        static constexpr size_t CHUNK_SIZE = LOGANYWHERE_REGISTRY_CHUNK; ///< Entries per growable chunk
+
+        /// Resource-backed block of entries (growable mode); never moved once allocated.
+        struct HandlerChunk
+        {
+            HandlerChunk *next;
+            HandlerEntry entries[CHUNK_SIZE];
+        };
+
+        // Growable mode only (resource.allocate != nullptr)
+        MemoryResource resource;        ///< Allocator, all-null in static mode
+        size_t inlineUsed;              ///< handlers[] slots handed out so far
+        HandlerChunk *chunks;           ///< Newest chunk first
+        size_t chunkUsed;               ///< Slots handed out in the newest chunk
+        HandlerEntry *freeList;         ///< Deleted slots, linked through HandlerEntry::context
+        HandlerEntry **directory;       ///< Live entries in registration order
+        size_t directoryCapacity;       ///< Capacity of directory
+#endif
+#if LOGANYWHERE_ENABLE_STATS
+        mutable RoutingStats routingStats; ///< Sharded totals, written by Logger
+#endif
+
+        friend class Logger;
+        friend class RoutingTransaction;
 
         // --------------------------------------------------------------------
         // Single‐purpose helper methods
@@ -152,7 +465,7 @@ namespace LogAnywhere
 
         /**
          * @brief Checks if there's capacity for another handler.
-         * @return true if handlerCount < MAX_HANDLERS.
+         * @return true if handlerCount < MAX_HANDLERS (always true when growable).
          */
         bool hasCapacity() const;
 
@@ -164,9 +477,9 @@ namespace LogAnywhere
          * @param tagList   Tags to subscribe to.
          * @param tagCount  Number of tags.
          * @param name      Optional name.
-         * @return Reference to the newly created HandlerEntry.
+         * @return The newly created HandlerEntry, or nullptr if no memory was available.
          */
-        HandlerEntry &createEntry(LogLevel level,
+        HandlerEntry *createEntry(LogLevel level,
                                   LogHandler fn,
                                   void *ctx,
                                   const Tag *tagList[],
@@ -178,11 +491,31 @@ namespace LogAnywhere
          * @param entry     The HandlerEntry to subscribe.
          * @param tagList   Array of Tag* pointers.
          * @param tagCount  Number of tags to subscribe to.
+         * @return false if a growable manager ran out of memory part-way.
          */
-        void subscribeEntryToTags(HandlerEntry *entry,
+        bool subscribeEntryToTags(HandlerEntry *entry,
                                   const Tag *tagList[],
                                   size_t tagCount);
 
+        /**
+         * @brief Subscribes a pattern handler to every live Tag it matches.
+         * @param entry The HandlerEntry whose patterns to resolve.
+         * @return false if a growable manager ran out of memory part-way.
+         */
+        bool subscribeEntryToPatterns(HandlerEntry *entry);
+
+        /// @return true if @p tag's name matches one of @p entry's patterns.
+        static bool matchesPatterns(const HandlerEntry *entry, const Tag *tag);
+
+        /// detail::tagCreatedHook: joins a new Tag to every matching pattern handler.
+        static void subscribeNewTag(Tag *tag);
+
+        /**
+         * @brief Picks the next ID that is neither 0 nor held by a live handler.
+         * @return A free handler ID.
+         */
+        uint16_t allocateId();
+
         /**
          * @brief Finds a handler entry by its ID.
          * @param id Unique handler ID.
@@ -209,6 +542,79 @@ namespace LogAnywhere
          * @param index Index of the slot to remove.
          */
         void compactHandlerArray(size_t index);
+
+        /**
+         * @brief Removes a handler from the registry after it left its Tags.
+         * @param entry Entry returned by findEntryByID()/findEntryByName().
+         */
+        void removeEntry(HandlerEntry *entry);
+
+        /**
+         * @brief Deletes several handlers in one pass (see RoutingTransaction).
+         * @param entries Distinct live entries to delete.
+         * @param count   Number of entries.
+         */
+        void removeEntries(HandlerEntry *const *entries, size_t count);
+
+        /**
+         * @brief Moves handlers[from] to handlers[to] and re-points its Tags.
+         * @param from Current slot.
+         * @param to   Destination slot.
+         */
+        void relocateEntry(size_t from, size_t to);
+
+        /// @return The index-th live entry in registration order.
+        HandlerEntry *entryAt(size_t index)
+        {
+#if LOGANYWHERE_ENABLE_GROWABLE
+            if (directory)
+                return directory[index];
+#endif
+            return &handlers[index];
+        }
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        /**
+         * @brief Hands out a never-used or freed slot (growable mode).
+         * @return Slot for a new entry, or nullptr if the resource is exhausted.
+         */
+        HandlerEntry *acquireSlot();
+
+        /// Puts a slot (live or just acquired) back on the free list.
+        void releaseSlot(HandlerEntry *entry);
+
+        /**
+         * @brief Makes room for one more directory pointer (growable mode).
+         * @return false if the resource is exhausted.
+         */
+        bool reserveDirectory();
+
+        /// Returns every chunk to the resource.
+        void releaseChunks();
+
+        /// Returns an entry's out-of-line tag list, if any, to the resource.
+        void releaseExtraTags(HandlerEntry *entry);
+#endif
+
+        /**
+         * @brief Appends @p entry to a Tag, growing a full list when growable.
+         * @return false if the Tag is full and could not grow.
+         */
+        bool addSubscriber(Tag *tag, const HandlerEntry *entry);
+
+        /// Removes every occurrence of @p entry from a Tag's subscriber list.
+        static void removeSubscriber(Tag *tag, const HandlerEntry *entry);
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        /// Bytes of a grown subscriber list with its dispatch columns.
+        static size_t subscriberBlockBytes(size_t capacity);
+
+        /// Returns a Tag's grown subscriber list, if any, to its resource.
+        static void releaseSubscriberBlock(Tag *tag);
+#endif
+
+        /// Re-points a Tag's subscriptions after an entry moved slots.
+        static void replaceSubscriber(Tag *tag, const HandlerEntry *from, const HandlerEntry *to);
     };
 
     // ──────────────────────────────────────────────────────────────────────────────
@@ -222,14 +628,18 @@ namespace LogAnywhere
      */
     inline bool HandlerManager::hasCapacity() const
     {
-        return handlerCount < MAX_HANDLERS;
+        // A growable manager is bounded by the 65535 usable IDs
+        return isGrowable() ? handlerCount < UINT16_MAX : handlerCount < MAX_HANDLERS;
     }
 
     /**
      * @brief Constructs a new HandlerEntry in the internal array.
      *
      * Creates a HandlerEntry with the given parameters at the next free slot,
-     * assigns it a unique ID, and increments the handler count.
+     * assigns it a unique ID, and increments the handler count.  In growable
+     * mode the slot may be a reused one or come from a new chunk, a tag list
+     * longer than MAX_TAG_SUBSCRIPTIONS is copied to the resource, and the
+     * entry is appended to the directory.
      *
      * @param level     Minimum log level threshold for this handler.
      * @param fn        Callback function pointer to invoke on log dispatch.
@@ -237,44 +647,423 @@ namespace LogAnywhere
      * @param tagList   Array of Tag* pointers this handler should subscribe to.
      * @param tagCount  Number of tags in @p tagList.
      * @param name      Optional human-readable name for diagnostics or removal.
-     * @return Reference to the newly created HandlerEntry.
+     * @return The newly created HandlerEntry, or nullptr if no memory was available.
      */
-    inline HandlerEntry &HandlerManager::createEntry(LogLevel level,
+    inline HandlerEntry *HandlerManager::createEntry(LogLevel level,
                                                      LogHandler fn,
                                                      void *ctx,
                                                      const Tag *tagList[],
                                                      size_t tagCount,
                                                      const char *name)
     {
-        HandlerEntry &e = handlers[handlerCount];
-        e = HandlerEntry(nextHandlerId++, name, level, fn, ctx, tagList, tagCount, true);
-        return handlers[handlerCount++];
+        HandlerEntry *e = nullptr;
+#if LOGANYWHERE_ENABLE_GROWABLE
+        const Tag **extraTags = nullptr;
+        if (!isGrowable())
+            e = &handlers[handlerCount];
+        else
+        {
+            if (!reserveDirectory() || !(e = acquireSlot()))
+                return nullptr;
+            if (tagCount > MAX_TAG_SUBSCRIPTIONS)
+            {
+                extraTags = static_cast<const Tag **>(
+                    resource.allocateBytes(tagCount * sizeof(Tag *), alignof(Tag *)));
+                if (!extraTags)
+                {
+                    releaseSlot(e);
+                    return nullptr;
+                }
+                std::memcpy(extraTags, tagList, tagCount * sizeof(Tag *));
+            }
+        }
+#else
+        e = &handlers[handlerCount];
+#endif
+        *e = HandlerEntry(allocateId(), name, level, fn, ctx, tagList, tagCount, true);
+#if LOGANYWHERE_ENABLE_GROWABLE
+        if (extraTags)
+        {
+            e->extraTags = extraTags;
+            e->tagCount = tagCount;
+        }
+        if (isGrowable())
+            directory[handlerCount] = e;
+#endif
+        ++handlerCount;
+        return e;
     }
 
+    /**
+     * @brief Picks the next ID, skipping 0 and IDs still held after wrap-around.
+     *
+     * @return A handler ID that no live handler uses.
+     */
+    inline uint16_t HandlerManager::allocateId()
+    {
+        for (;;)
+        {
+            uint16_t id = nextHandlerId++;
+            if (id != 0 && !findEntryByID(id))
+                return id;
+        }
+    }
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+    /**
+     * @brief Finds a slot for a new entry without moving any live one.
+     *
+     * Freed slots are reused first, then the inline handlers[] array, then
+     * the newest chunk; a new chunk is allocated when all are taken.
+     *
+     * @return Slot for a new entry, or nullptr if the resource is exhausted.
+     */
+    inline HandlerEntry *HandlerManager::acquireSlot()
+    {
+        if (freeList)
+        {
+            HandlerEntry *e = freeList;
+            freeList = static_cast<HandlerEntry *>(e->context);
+            return e;
+        }
+        if (inlineUsed < MAX_HANDLERS)
+            return &handlers[inlineUsed++];
+        if (!chunks || chunkUsed == CHUNK_SIZE)
+        {
+            void *mem = resource.allocateBytes(sizeof(HandlerChunk), alignof(HandlerChunk));
+            if (!mem)
+                return nullptr;
+            HandlerChunk *c = new (mem) HandlerChunk();
+            c->next = chunks;
+            chunks = c;
+            chunkUsed = 0;
+        }
+        return &chunks->entries[chunkUsed++];
+    }
+
+    /**
+     * @brief Wipes a slot and pushes it on the free list.
+     *
+     * A free slot is unreachable from the directory and from every Tag, so
+     * its context field doubles as the list link.
+     *
+     * @param entry Slot to recycle.
+     */
+    inline void HandlerManager::releaseSlot(HandlerEntry *entry)
+    {
+        *entry = HandlerEntry{};
+        entry->context = freeList;
+        freeList = entry;
+    }
+
+    /**
+     * @brief Ensures the directory can take one more entry.
+     *
+     * Doubles the pointer array when full.  Only the directory moves; the
+     * entries it points at stay where they are.
+     *
+     * @return false if the resource is exhausted.
+     */
+    inline bool HandlerManager::reserveDirectory()
+    {
+        if (handlerCount < directoryCapacity)
+            return true;
+        size_t capacity = directoryCapacity ? directoryCapacity * 2 : MAX_HANDLERS + CHUNK_SIZE;
+        auto **grown = static_cast<HandlerEntry **>(
+            resource.allocateBytes(capacity * sizeof(HandlerEntry *), alignof(HandlerEntry *)));
+        if (!grown)
+            return false;
+        if (handlerCount)
+            std::memcpy(grown, directory, handlerCount * sizeof(HandlerEntry *));
+        resource.deallocateBytes(directory, directoryCapacity * sizeof(HandlerEntry *), alignof(HandlerEntry *));
+        directory = grown;
+        directoryCapacity = capacity;
+        return true;
+    }
+
+    /**
+     * @brief Returns every chunk to the resource.
+     *
+     * Only called once no Tag refers to the chunk entries any more.
+     */
+    inline void HandlerManager::releaseChunks()
+    {
+        while (chunks)
+        {
+            HandlerChunk *next = chunks->next;
+            chunks->~HandlerChunk();
+            resource.deallocateBytes(chunks, sizeof(HandlerChunk), alignof(HandlerChunk));
+            chunks = next;
+        }
+        chunkUsed = 0;
+    }
+
+    /**
+     * @brief Frees the out-of-line tag list of an entry, if it has one.
+     *
+     * @param entry Entry about to be wiped.
+     */
+    inline void HandlerManager::releaseExtraTags(HandlerEntry *entry)
+    {
+        if (!entry->extraTags)
+            return;
+        resource.deallocateBytes(entry->extraTags, entry->tagCount * sizeof(Tag *), alignof(Tag *));
+        entry->extraTags = nullptr;
+        entry->tagCount = 0;
+    }
+#endif
+
     /**
      * @brief Subscribes a HandlerEntry to each Tag in the provided list.
      *
-     * For each tag in @p tagList, if there is capacity, appends the
-     * @p entry pointer into that Tag's subscriber array.
+     * For each tag the entry kept (at most MAX_TAG_SUBSCRIPTIONS in static
+     * mode, so every subscription can later be undone), appends the
+     * @p entry pointer into that Tag's subscriber array if there is
+     * capacity.  Subscriptions refused because a tag is full, or cut off
+     * by the per-handler limit, are counted when statistics are enabled.
      *
      * @param entry     Pointer to the HandlerEntry to subscribe.
      * @param tagList   Array of Tag* pointers to subscribe to.
      * @param tagCount  Number of tags in @p tagList.
+     * @return false if a growable manager could not grow a Tag's list.
      */
-    inline void HandlerManager::subscribeEntryToTags(HandlerEntry *entry,
+    inline bool HandlerManager::subscribeEntryToTags(HandlerEntry *entry,
                                                      const Tag *tagList[],
                                                      size_t tagCount)
     {
-        for (size_t i = 0; i < tagCount; ++i)
+        (void)tagList;
+#if LOGANYWHERE_ENABLE_STATS
+        if (tagCount > entry->tagCount)
+        {
+            entry->droppedSubscriptions += static_cast<uint32_t>(tagCount - entry->tagCount);
+            routingStats.countDroppedSubscriptions(tagCount - entry->tagCount);
+        }
+#else
+        (void)tagCount;
+#endif
+        for (size_t i = 0; i < entry->tagCount; ++i)
+        {
+            bool added = addSubscriber(const_cast<Tag *>(entry->tagAt(i)), entry);
+            if (!added && isGrowable())
+                return false;
+#if LOGANYWHERE_ENABLE_STATS
+            if (!added)
+            {
+                ++entry->droppedSubscriptions;
+                routingStats.countDroppedSubscriptions(1);
+            }
+#endif
+        }
+        return true;
+    }
+
+    /**
+     * @brief Resolves an entry's wildcard patterns against the live Tags.
+     *
+     * Matching Tags get @p entry appended to their subscriber list.  Full
+     * Tags are counted as dropped subscriptions in static mode, as in
+     * subscribeEntryToTags().
+     *
+     * @param entry Entry with patterns set.
+     * @return false if a growable manager could not grow a Tag's list.
+     */
+    inline bool HandlerManager::subscribeEntryToPatterns(HandlerEntry *entry)
+    {
+        for (Tag *tag = detail::liveTags; tag; tag = tag->nextTag)
+        {
+            if (!matchesPatterns(entry, tag))
+                continue;
+            bool added = addSubscriber(tag, entry);
+            if (!added && isGrowable())
+                return false;
+#if LOGANYWHERE_ENABLE_STATS
+            if (!added)
+            {
+                ++entry->droppedSubscriptions;
+                routingStats.countDroppedSubscriptions(1);
+            }
+#endif
+        }
+        return true;
+    }
+
+    /**
+     * @brief Tests a Tag against every pattern of an entry.
+     *
+     * @param entry Entry whose patterns to test.
+     * @param tag   Candidate Tag.
+     * @return true on the first matching pattern.
+     */
+    inline bool HandlerManager::matchesPatterns(const HandlerEntry *entry, const Tag *tag)
+    {
+        for (size_t p = 0; p < entry->patternCount; ++p)
         {
-            Tag *t = const_cast<Tag *>(tagList[i]);
-            if (t->handlerCount < MAX_TAG_SUBSCRIPTIONS)
+            if (matchesTagPattern(entry->patterns[p], tag->name))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Joins a just-constructed Tag to every matching pattern handler.
+     *
+     * Installed as detail::tagCreatedHook, so it runs for Tags of every
+     * live manager.  A Tag that is full or cannot grow is counted as a
+     * dropped subscription (with statistics) rather than failing the Tag.
+     *
+     * @param tag The new Tag.
+     */
+    inline void HandlerManager::subscribeNewTag(Tag *tag)
+    {
+        for (HandlerManager *mgr = detail::liveManagers; mgr; mgr = mgr->nextManager)
+        {
+            for (size_t i = 0; i < mgr->handlerCount; ++i)
             {
-                t->handlers[t->handlerCount++] = entry;
+                HandlerEntry *e = mgr->entryAt(i);
+                if (!e->patternCount || !matchesPatterns(e, tag))
+                    continue;
+                bool added = mgr->addSubscriber(tag, e);
+#if LOGANYWHERE_ENABLE_STATS
+                if (!added)
+                {
+                    ++e->droppedSubscriptions;
+                    mgr->routingStats.countDroppedSubscriptions(1);
+                }
+#else
+                (void)added;
+#endif
             }
         }
     }
 
+    /**
+     * @brief Appends one subscriber to a Tag and rebuilds its dispatch lists.
+     *
+     * A full Tag is refused in static mode.  A growable manager instead
+     * moves the list and its columns to one block twice the size taken
+     * from its resource (see subscriberBlockBytes()).
+     *
+     * @param tag   Tag to extend.
+     * @param entry Subscriber to append.
+     * @return true if @p entry was added.
+     */
+    inline bool HandlerManager::addSubscriber(Tag *tag, const HandlerEntry *entry)
+    {
+        if (tag->handlerCount >= tag->subscriberLimit())
+        {
+#if LOGANYWHERE_ENABLE_GROWABLE
+            if (!isGrowable())
+                return false;
+            size_t capacity = tag->subscriberCapacity * 2;
+            void *block = resource.allocateBytes(subscriberBlockBytes(capacity), alignof(HandlerEntry *));
+            if (!block)
+                return false;
+            // Pointer-sized arrays first, then groups: all aligned
+            auto *bytes = static_cast<unsigned char *>(block);
+            auto **grown = reinterpret_cast<const HandlerEntry **>(bytes);
+            SubscriberColumns c;
+            c.entries = grown + capacity;
+            c.fns = reinterpret_cast<LogHandler *>(bytes + 2 * capacity * sizeof(HandlerEntry *));
+            c.contexts = reinterpret_cast<void **>(c.fns + capacity);
+            c.groups = reinterpret_cast<HandlerGroups *>(c.contexts + capacity);
+
+            // The columns are rebuilt below; only the list itself moves
+            std::memcpy(grown, tag->subscribers, tag->handlerCount * sizeof(HandlerEntry *));
+            releaseSubscriberBlock(tag);
+            tag->subscribers = grown;
+            tag->grownColumns = c;
+            tag->subscriberCapacity = capacity;
+            tag->subscriberResource = &resource;
+#else
+            return false;
+#endif
+        }
+        tag->subscriberList()[tag->handlerCount++] = entry;
+        tag->rebuildDispatch();
+        return true;
+    }
+
+    /**
+     * @brief Removes @p entry from a Tag and closes the gap.
+     *
+     * A grown list is kept until the Tag has no subscribers left, then
+     * its storage is returned to the resource and the Tag goes back to
+     * its inline array.  Keeping it avoids a fresh allocation (which a
+     * monotonic arena never reclaims) on every add/delete around the limit.
+     *
+     * @param tag   Tag to prune.
+     * @param entry Subscriber to remove.
+     */
+    inline void HandlerManager::removeSubscriber(Tag *tag, const HandlerEntry *entry)
+    {
+        const HandlerEntry **list = tag->subscriberList();
+        size_t wr = 0;
+        for (size_t rd = 0; rd < tag->handlerCount; ++rd)
+        {
+            // id 0 marks entries being deleted in the same batch (removeEntries)
+            if (list[rd] != entry && list[rd]->id != 0)
+                list[wr++] = list[rd];
+        }
+        tag->handlerCount = wr;
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        if (tag->subscriberResource && wr == 0)
+        {
+            releaseSubscriberBlock(tag);
+            tag->subscribers = tag->handlers;
+            tag->grownColumns = SubscriberColumns{};
+            tag->subscriberCapacity = MAX_TAG_SUBSCRIPTIONS;
+            tag->subscriberResource = nullptr;
+        }
+#endif
+        tag->rebuildDispatch();
+    }
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+    /**
+     * @brief Size of a grown subscriber list: entry pointers plus columns.
+     * @param capacity Subscribers the block holds.
+     */
+    inline size_t HandlerManager::subscriberBlockBytes(size_t capacity)
+    {
+        return capacity * (2 * sizeof(HandlerEntry *) + sizeof(LogHandler) + sizeof(void *) +
+                           sizeof(HandlerGroups));
+    }
+
+    /// Returns a Tag's grown subscriber block, if any, to its resource.
+    inline void HandlerManager::releaseSubscriberBlock(Tag *tag)
+    {
+        if (tag->subscriberResource)
+            tag->subscriberResource->deallocateBytes(tag->subscribers,
+                                                     subscriberBlockBytes(tag->subscriberCapacity),
+                                                     alignof(HandlerEntry *));
+    }
+#endif
+
+    /**
+     * @brief Re-points a Tag's subscriptions from one slot to another.
+     *
+     * @param tag  Tag the moved entry subscribed to.
+     * @param from Old address of the entry.
+     * @param to   New address of the entry.
+     */
+    inline void HandlerManager::replaceSubscriber(Tag *tag, const HandlerEntry *from, const HandlerEntry *to)
+    {
+        const HandlerEntry **list = tag->subscriberList();
+        for (size_t i = 0; i < tag->handlerCount; ++i)
+        {
+            if (list[i] == from)
+                list[i] = to;
+        }
+        // The moved entry is unchanged, so its dispatch row keeps its place
+        const SubscriberColumns hot = tag->columns();
+        for (size_t r = 0; r < tag->dispatchRows; ++r)
+        {
+            if (hot.entries[r] == from)
+                hot.entries[r] = to;
+        }
+    }
+
     /**
      * @brief Finds a registered handler by its unique ID.
      *
@@ -288,8 +1077,9 @@ namespace LogAnywhere
     {
         for (size_t i = 0; i < handlerCount; ++i)
         {
-            if (handlers[i].id == id)
-                return &handlers[i];
+            HandlerEntry *e = entryAt(i);
+            if (e->id == id)
+                return e;
         }
         return nullptr;
     }
@@ -307,8 +1097,9 @@ namespace LogAnywhere
     {
         for (size_t i = 0; i < handlerCount; ++i)
         {
-            if (handlers[i].name && std::strcmp(handlers[i].name, name) == 0)
-                return &handlers[i];
+            HandlerEntry *e = entryAt(i);
+            if (e->name && std::strcmp(e->name, name) == 0)
+                return e;
         }
         return nullptr;
     }
@@ -316,23 +1107,23 @@ namespace LogAnywhere
     /**
      * @brief Unsubscribes a HandlerEntry from all Tags it was registered to.
      *
-     * For each Tag in the entry’s tagList, removes the entry pointer from
-     * the Tag’s handlers array and compacts the array to close gaps.
+     * For each Tag in the entry’s tagList, and each live Tag matching its
+     * patterns, removes the entry pointer from the Tag’s subscriber array
+     * and compacts the array to close gaps.
      *
      * @param entry Pointer to the HandlerEntry to remove from all tags.
      */
     inline void HandlerManager::unsubscribeEntryFromTags(HandlerEntry *entry)
     {
         for (size_t t = 0; t < entry->tagCount; ++t)
+            removeSubscriber(const_cast<Tag *>(entry->tagAt(t)), entry);
+        if (!entry->patternCount)
+            return;
+        // Pattern subscriptions are not recorded per entry; re-match instead
+        for (Tag *tag = detail::liveTags; tag; tag = tag->nextTag)
         {
-            Tag *tag = const_cast<Tag *>(entry->tagList[t]);
-            size_t wr = 0;
-            for (size_t rd = 0; rd < tag->handlerCount; ++rd)
-            {
-                if (tag->handlers[rd] != entry)
-                    tag->handlers[wr++] = tag->handlers[rd];
-            }
-            tag->handlerCount = wr;
+            if (matchesPatterns(entry, tag))
+                removeSubscriber(tag, entry);
         }
     }
 
@@ -340,19 +1131,192 @@ namespace LogAnywhere
      * @brief Removes a handler slot from the internal array by index.
      *
      * Shifts all entries after @p index one position left to fill the gap,
-     * then decrements the handler count.
+     * re-pointing their Tag subscriptions at the new slots, then decrements
+     * the handler count.
      *
      * @param index Index of the handler slot to remove.
      */
     inline void HandlerManager::compactHandlerArray(size_t index)
     {
         for (size_t i = index + 1; i < handlerCount; ++i)
+            relocateEntry(i, i - 1);
+        --handlerCount;
+    }
+
+    /**
+     * @brief Copies an entry to another slot and re-points its subscriptions.
+     *
+     * @param from Slot the entry currently occupies.
+     * @param to   Free slot to move it to.
+     */
+    inline void HandlerManager::relocateEntry(size_t from, size_t to)
+    {
+        handlers[to] = handlers[from];
+        for (size_t t = 0; t < handlers[to].tagCount; ++t)
+            replaceSubscriber(const_cast<Tag *>(handlers[to].tagList[t]), &handlers[from], &handlers[to]);
+        if (!handlers[to].patternCount)
+            return;
+        for (Tag *tag = detail::liveTags; tag; tag = tag->nextTag)
         {
-            handlers[i - 1] = handlers[i];
+            if (matchesPatterns(&handlers[to], tag))
+                replaceSubscriber(tag, &handlers[from], &handlers[to]);
         }
-        --handlerCount;
     }
 
+    /**
+     * @brief Deletes a batch of handlers with one sweep per Tag and one
+     *        pass over the registry.
+     *
+     * The entries are first marked (id 0), so the first removeSubscriber()
+     * on a shared Tag drops every marked subscriber at once.  Static mode
+     * then compacts handlers[] in a single pass, moving each survivor at
+     * most once; growable mode filters the directory in a single pass.
+     *
+     * @param entries Distinct live entries of this manager.
+     * @param count   Number of entries.
+     */
+    inline void HandlerManager::removeEntries(HandlerEntry *const *entries, size_t count)
+    {
+        if (count == 0)
+            return;
+        for (size_t i = 0; i < count; ++i)
+            entries[i]->id = 0;
+        for (size_t i = 0; i < count; ++i)
+            unsubscribeEntryFromTags(entries[i]);
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+        if (isGrowable())
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < handlerCount; ++i)
+            {
+                HandlerEntry *e = directory[i];
+                if (e->id != 0)
+                {
+                    directory[kept++] = e;
+                    continue;
+                }
+                releaseExtraTags(e);
+                releaseSlot(e);
+            }
+            handlerCount = kept;
+            return;
+        }
+#endif
+        size_t kept = 0;
+        for (size_t i = 0; i < handlerCount; ++i)
+        {
+            if (handlers[i].id == 0)
+                continue;
+            if (kept != i)
+                relocateEntry(i, kept);
+            ++kept;
+        }
+        for (size_t i = kept; i < handlerCount; ++i)
+            handlers[i] = HandlerEntry{};
+        handlerCount = kept;
+    }
+
+    /**
+     * @brief Drops an unsubscribed entry from the registry.
+     *
+     * Static mode compacts handlers[].  Growable mode only removes the
+     * directory pointer and puts the slot on the free list, so every other
+     * entry stays at its address.
+     *
+     * @param entry Entry to remove; must belong to this manager.
+     */
+    inline void HandlerManager::removeEntry(HandlerEntry *entry)
+    {
+#if LOGANYWHERE_ENABLE_GROWABLE
+        if (isGrowable())
+        {
+            size_t index = 0;
+            while (directory[index] != entry)
+                ++index;
+            std::memmove(directory + index, directory + index + 1, (handlerCount - index - 1) * sizeof(HandlerEntry *));
+            --handlerCount;
+            releaseExtraTags(entry);
+            releaseSlot(entry);
+            return;
+        }
+#endif
+        compactHandlerArray(static_cast<size_t>(entry - handlers));
+    }
+
+#if LOGANYWHERE_ENABLE_STATS
+    /**
+     * @brief Sums every shard into a RoutingStatsSnapshot.
+     *
+     * Rows cover the first MAX_HANDLERS handlers in registration order;
+     * a growable manager with more handlers reads the rest through
+     * snapshotHandlerStats().
+     *
+     * @return Totals by level and drop reason plus per-handler counters.
+     */
+    inline RoutingStatsSnapshot HandlerManager::snapshotStats() const
+    {
+        RoutingStatsSnapshot out;
+        routingStats.sumTotals(out);
+        out.handlerCount = snapshotHandlerStats(out.handlers, MAX_HANDLERS);
+        return out;
+    }
+
+    /**
+     * @brief Sums the sharded counters of each handler into @p out.
+     *
+     * @param out      Destination rows.
+     * @param capacity Number of rows in @p out.
+     * @param first    Registration index of the first handler to report.
+     * @return Number of rows written.
+     */
+    inline size_t HandlerManager::snapshotHandlerStats(HandlerStats *out, size_t capacity, size_t first) const
+    {
+        size_t rows = 0;
+        for (size_t i = first; i < handlerCount && rows < capacity; ++i)
+        {
+            const HandlerEntry *e = const_cast<HandlerManager *>(this)->entryAt(i);
+            HandlerStats &h = out[rows++];
+            e->counters.sum(h);
+            h.id = e->id;
+            h.name = e->name;
+            h.droppedSubscriptions = e->droppedSubscriptions;
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Reads the per-level counters stored on a Tag.
+     *
+     * @param tag Tag to inspect.
+     * @return Counts by level and their sum.
+     */
+    inline TagStatsSnapshot HandlerManager::snapshotStats(const Tag *tag) const
+    {
+        TagStatsSnapshot out;
+        out.total = 0;
+        for (size_t l = 0; l < LOG_LEVEL_COUNT; ++l)
+        {
+            out.logged[l] = tag->logged.sum(l);
+            out.total += out.logged[l];
+        }
+        return out;
+    }
+
+    /**
+     * @brief Zeroes all counters held by this manager and its handlers.
+     */
+    inline void HandlerManager::resetStats()
+    {
+        routingStats.reset();
+        for (size_t i = 0; i < handlerCount; ++i)
+        {
+            entryAt(i)->droppedSubscriptions = 0;
+            entryAt(i)->counters.reset();
+        }
+    }
+#endif
+
     /**
      * @brief Registers a handler for a list of Tag* subscriptions.
      *
@@ -365,7 +1329,8 @@ namespace LogAnywhere
      * @param tagList   Array of Tag* pointers this handler should subscribe to.
      * @param tagCount  Number of tags in @p tagList.
      * @param name      Optional human-readable name for diagnostics or removal.
-     * @return true if registration succeeded, false if capacity is exceeded.
+     * @return true if registration succeeded, false if capacity is exceeded
+     *         or a growable manager ran out of memory.
      */
     inline bool HandlerManager::registerHandlerForTags(LogLevel level,
                                                        LogHandler fn,
@@ -376,16 +1341,63 @@ namespace LogAnywhere
     {
         if (!hasCapacity())
             return false;
-        auto &entry = createEntry(level, fn, ctx, tagList, tagCount, name);
-        subscribeEntryToTags(&entry, tagList, tagCount);
+        HandlerEntry *entry = createEntry(level, fn, ctx, tagList, tagCount, name);
+        if (!entry)
+            return false;
+        if (!subscribeEntryToTags(entry, tagList, tagCount))
+        {
+            // Out of memory part-way: undo the partial subscription and the entry
+            unsubscribeEntryFromTags(entry);
+            removeEntry(entry);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Registers a handler for all Tags matching wildcard patterns.
+     *
+     * Creates an entry without explicit tags, records @p patterns on it
+     * and resolves them against the live Tags.  Tags constructed later are
+     * joined by subscribeNewTag().
+     *
+     * @param level        Minimum log level threshold for this handler.
+     * @param fn           Callback function pointer to invoke on log dispatch.
+     * @param ctx          User-supplied context passed to the callback.
+     * @param patterns     Wildcard patterns, caller-owned.
+     * @param patternCount Number of patterns in @p patterns.
+     * @param name         Optional human-readable name for diagnostics or removal.
+     * @return true if registration succeeded, false if capacity is exceeded
+     *         or a growable manager ran out of memory.
+     */
+    inline bool HandlerManager::registerHandlerForPatterns(LogLevel level,
+                                                           LogHandler fn,
+                                                           void *ctx,
+                                                           const char *const patterns[],
+                                                           size_t patternCount,
+                                                           const char *name)
+    {
+        if (!hasCapacity())
+            return false;
+        HandlerEntry *entry = createEntry(level, fn, ctx, nullptr, 0, name);
+        if (!entry)
+            return false;
+        entry->patterns = patterns;
+        entry->patternCount = patternCount;
+        if (!subscribeEntryToPatterns(entry))
+        {
+            unsubscribeEntryFromTags(entry);
+            removeEntry(entry);
+            return false;
+        }
         return true;
     }
 
     /**
      * @brief Deletes a handler by its unique ID.
      *
-     * Finds the entry by ID, unsubscribes it from all Tags, and compacts
-     * the internal handler array.
+     * Finds the entry by ID, unsubscribes it from all Tags, and removes it
+     * from the registry (compacting handlers[] in static mode).
      *
      * @param id Unique identifier of the handler to delete.
      * @return true if the handler was found and deleted; false otherwise.
@@ -396,15 +1408,15 @@ namespace LogAnywhere
         if (!e)
             return false;
         unsubscribeEntryFromTags(e);
-        compactHandlerArray(static_cast<size_t>(e - handlers));
+        removeEntry(e);
         return true;
     }
 
     /**
      * @brief Deletes a handler by its name
      *
-     * Finds the entry by name, unsubscribes it from all Tags, and compacts
-     * the internal handler array.
+     * Finds the entry by name, unsubscribes it from all Tags, and removes it
+     * from the registry (compacting handlers[] in static mode).
      *
      * @param name Name of the handler to delete.
      * @return true if the handler was found and deleted; false otherwise.
@@ -415,7 +1427,7 @@ namespace LogAnywhere
         if (!e)
             return false;
         unsubscribeEntryFromTags(e);
-        compactHandlerArray(static_cast<size_t>(e - handlers));
+        removeEntry(e);
         return true;
     }
 }; // namespace LogAnywhere
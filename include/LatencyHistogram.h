@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * @file LatencyHistogram.h
+ * @brief Lock-free log-linear (HDR-style) histogram for latency samples.
+ *
+ * Values are bucketed by power of two, and each power of two is split into
+ * 2^LOGANYWHERE_LATENCY_SUB_BUCKET_BITS linear sub-buckets, so every
+ * reported percentile is within 1 / 2^bits of the true value (12.5% with
+ * the default of 3 bits) while the whole range up to
+ * 2^LOGANYWHERE_LATENCY_MAX_EXPONENT fits in a few hundred counters.
+ *
+ * record() is one relaxed fetch_add per counter and never blocks, so any
+ * number of threads may record concurrently; queries read a consistent
+ * enough view without stopping writers.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// log2 of the number of linear sub-buckets per power of two.
+#ifndef LOGANYWHERE_LATENCY_SUB_BUCKET_BITS
+#define LOGANYWHERE_LATENCY_SUB_BUCKET_BITS 3
+#endif
+
+/// Values of 2^N and above share the last bucket (max() stays exact).
+#ifndef LOGANYWHERE_LATENCY_MAX_EXPONENT
+#define LOGANYWHERE_LATENCY_MAX_EXPONENT 36
+#endif
+
+/// Monotonic time source for latency samples, in nanoseconds.
+#ifndef LOGANYWHERE_LATENCY_NOW
+#include <chrono>
+#define LOGANYWHERE_LATENCY_NOW()                                                \
+    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>( \
+                              std::chrono::steady_clock::now().time_since_epoch()) \
+                              .count())
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Fixed-size, allocation-free latency histogram.
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr unsigned SUB_BUCKET_BITS = LOGANYWHERE_LATENCY_SUB_BUCKET_BITS;
+        static constexpr unsigned MAX_EXPONENT = LOGANYWHERE_LATENCY_MAX_EXPONENT;
+        static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+        static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+        static_assert(MAX_EXPONENT > SUB_BUCKET_BITS && MAX_EXPONENT < 64, "invalid latency histogram range");
+
+        LatencyHistogram() { reset(); }
+
+        /// Copies a snapshot of @p other (needed because HandlerEntry is copied on compaction).
+        LatencyHistogram(const LatencyHistogram &other) { copyFrom(other); }
+
+        LatencyHistogram &operator=(const LatencyHistogram &other)
+        {
+            if (this != &other)
+                copyFrom(other);
+            return *this;
+        }
+
+        /**
+         * @brief Adds one sample.  Lock-free and safe from any thread.
+         * @param value Sample, typically nanoseconds.
+         */
+        void record(uint64_t value) noexcept
+        {
+            buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(value, std::memory_order_relaxed);
+            uint64_t seen = maxValue.load(std::memory_order_relaxed);
+            while (value > seen &&
+                   !maxValue.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /// Clears all samples.
+        void reset() noexcept
+        {
+            for (auto &b : buckets)
+                b.store(0, std::memory_order_relaxed);
+            total.store(0, std::memory_order_relaxed);
+            sum.store(0, std::memory_order_relaxed);
+            maxValue.store(0, std::memory_order_relaxed);
+        }
+
+        /// @return Number of recorded samples.
+        uint64_t count() const noexcept { return total.load(std::memory_order_relaxed); }
+
+        /// @return Largest recorded sample (exact).
+        uint64_t max() const noexcept { return maxValue.load(std::memory_order_relaxed); }
+
+        /// @return Mean of all samples, or 0 when empty.
+        uint64_t mean() const noexcept
+        {
+            uint64_t n = count();
+            return n ? sum.load(std::memory_order_relaxed) / n : 0;
+        }
+
+        /**
+         * @brief Returns the value at or below which @p percentile % of samples fall.
+         *
+         * The result is the upper edge of the bucket holding that rank,
+         * clamped to max().
+         *
+         * @param percentile In [0, 100].
+         * @return Sample value, or 0 when empty.
+         */
+        uint64_t valueAtPercentile(double percentile) const noexcept
+        {
+            uint64_t n = 0;
+            uint64_t counts[BUCKET_COUNT];
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+                n += counts[i] = buckets[i].load(std::memory_order_relaxed);
+            if (n == 0)
+                return 0;
+
+            if (percentile < 0.0)
+                percentile = 0.0;
+            if (percentile > 100.0)
+                percentile = 100.0;
+            uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(n) + 0.999999);
+            if (rank == 0)
+                rank = 1;
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                {
+                    uint64_t top = bucketUpperBound(i), m = max();
+                    return top < m ? top : m;
+                }
+            }
+            return max();
+        }
+
+        uint64_t p50() const noexcept { return valueAtPercentile(50.0); }
+        uint64_t p99() const noexcept { return valueAtPercentile(99.0); }
+        uint64_t p999() const noexcept { return valueAtPercentile(99.9); }
+
+        /// @return Bucket holding @p value.
+        static size_t bucketIndex(uint64_t value) noexcept
+        {
+            if (value < SUB_BUCKETS)
+                return static_cast<size_t>(value);
+            unsigned e = 63u - static_cast<unsigned>(__builtin_clzll(value));
+            if (e > MAX_EXPONENT)
+                return BUCKET_COUNT - 1;
+            uint64_t sub = (value >> (e - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+            return static_cast<size_t>((e - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub);
+        }
+
+        /// @return Largest value that maps to bucket @p index.
+        static uint64_t bucketUpperBound(size_t index) noexcept
+        {
+            if (index < SUB_BUCKETS)
+                return index;
+            if (index == BUCKET_COUNT - 1)
+                return UINT64_MAX;
+            uint64_t group = index / SUB_BUCKETS;
+            uint64_t sub = index % SUB_BUCKETS;
+            unsigned shift = static_cast<unsigned>(group - 1);
+            return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+        }
+
+    private:
+        std::atomic<uint64_t> buckets[BUCKET_COUNT];
+        std::atomic<uint64_t> total;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> maxValue;
+
+        void copyFrom(const LatencyHistogram &other) noexcept
+        {
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+                buckets[i].store(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            total.store(other.total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            sum.store(other.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            maxValue.store(other.maxValue.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    };
+
+} // namespace LogAnywhere
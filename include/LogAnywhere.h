@@ -15,10 +15,20 @@
 #include "LogLevel.h"
 #include "LogMessage.h"
 #include "Tag.h"
+#include "TagRegistry.h"
 #include "HandlerEntry.h"
 #include "HandlerManager.h"
 #include "Logger.h"
 
+/// Provide logFromSignal() / dispatchSignalLogs() backed by a SignalRing.
+#ifndef LOGANYWHERE_ENABLE_SIGNAL_LOG
+#define LOGANYWHERE_ENABLE_SIGNAL_LOG 0
+#endif
+
+#if LOGANYWHERE_ENABLE_SIGNAL_LOG
+#include "SignalRing.h"
+#endif
+
 namespace LogAnywhere
 {
 
@@ -60,6 +70,33 @@ namespace LogAnywhere
             level, handler, context, tags, tagCount, name);
     }
 
+    /**
+     * @brief Register a handler for every Tag matching wildcard patterns.
+     *
+     * Patterns use dotted tag names, e.g. "net.*" for every Tag below
+     * "net" (see TagPattern.h).  They are resolved now and whenever a Tag
+     * is created later; logging never matches patterns.
+     *
+     * @param level         Minimum severity level that triggers this handler
+     * @param handler       Callback to invoke for each matching LogMessage
+     * @param context       User data pointer passed through to the callback
+     * @param patterns      Wildcard patterns (must outlive the registration)
+     * @param patternCount  Number of entries in @p patterns
+     * @param name          Optional human-readable name (for diagnostics or removal)
+     * @return true on success; false if the handler limit was reached
+     */
+    inline bool registerHandlerForPatterns(
+        LogLevel level,
+        LogHandler handler,
+        void *context,
+        const char *const patterns[],
+        size_t patternCount,
+        const char *name = nullptr)
+    {
+        return handlerManager.registerHandlerForPatterns(
+            level, handler, context, patterns, patternCount, name);
+    }
+
     /**
      * @brief Completely remove a handler by its unique ID.
      *
@@ -136,28 +173,97 @@ namespace LogAnywhere
         const char *format,
         ...)
     {
-        char buffer[256];
         va_list args;
         va_start(args, format);
-        vsnprintf(buffer, sizeof(buffer), format, args);
+        logger.vlogf(level, tag, format, args);
         va_end(args);
+    }
+
+#if LOGANYWHERE_ENABLE_SIGNAL_LOG
+    //=== Signal / ISR logging ===//
+
+    /**
+     * @brief Ring that holds records from logFromSignal() until dispatched.
+     */
+    static SignalRing signalRing;
+
+    /**
+     * @brief Queue a preformatted message from a signal handler or ISR.
+     *
+     * Async-signal-safe and wait-free: the text is copied into a dedicated
+     * ring and no handler runs until dispatchSignalLogs() is called.
+     *
+     * @param level      Severity level of this message
+     * @param tag        Pointer to a static Tag instance
+     * @param message    Preformatted C-string (truncated to LOGANYWHERE_SIGNAL_TEXT - 1)
+     * @param timestamp  Optional timestamp (0→stamped when dispatched)
+     * @return false if the ring was full and the message was dropped
+     */
+    inline bool logFromSignal(
+        LogLevel level,
+        const Tag *tag,
+        const char *message,
+        uint64_t timestamp = 0) noexcept
+    {
+        return signalRing.log(level, tag, message, timestamp);
+    }
 
-        logger.log(level, tag, buffer);
+    /**
+     * @brief Run the handlers for messages queued by logFromSignal().
+     *
+     * Call from normal (non-signal) context, e.g. the main loop.
+     *
+     * @param maxRecords  Stop after this many messages
+     * @return Number of messages dispatched
+     */
+    inline size_t dispatchSignalLogs(size_t maxRecords = SIZE_MAX)
+    {
+        return signalRing.drain(logger, maxRecords);
+    }
+#endif
+
+    //=== Handler groups ===//
+
+    /**
+     * @brief Puts a named handler into groups (see handlerGroup()).
+     *
+     * @param name    Name of the handler
+     * @param groups  Bit set of groups
+     * @return true if the handler exists
+     */
+    inline bool setHandlerGroups(const char *name, HandlerGroups groups)
+    {
+        return handlerManager.setHandlerGroups(name, groups);
+    }
+
+    /**
+     * @brief Enable every handler group in @p groups with one atomic operation.
+     */
+    inline void enableGroups(HandlerGroups groups)
+    {
+        handlerManager.enableGroups(groups);
+    }
+
+    /**
+     * @brief Disable every handler group in @p groups with one atomic operation.
+     *
+     * Handlers in a disabled group are skipped until it is enabled again.
+     */
+    inline void disableGroups(HandlerGroups groups)
+    {
+        handlerManager.disableGroups(groups);
     }
 
     // Enable by name
     // ─────────────────────────────────────────────────────────────
     inline bool enableHandler(const char *name)
     {
-        size_t count = 0;
-        HandlerEntry *entries = const_cast<HandlerEntry *>(
-            handlerManager.listHandlers(count));
-
-        for (size_t i = 0; i < count; ++i)
+        for (size_t i = 0; i < handlerManager.registeredCount(); ++i)
         {
-            if (entries[i].name && std::strcmp(entries[i].name, name) == 0)
+            HandlerEntry *e = handlerManager.handlerAt(i);
+            if (e->name && std::strcmp(e->name, name) == 0)
             {
-                entries[i].setEnabled(true);
+                e->setEnabled(true);
                 return true;
             }
         }
@@ -166,15 +272,12 @@ namespace LogAnywhere
 
     inline bool disableHandler(const char *name)
     {
-        size_t count = 0;
-        HandlerEntry *entries = const_cast<HandlerEntry *>(
-            handlerManager.listHandlers(count));
-
-        for (size_t i = 0; i < count; ++i)
+        for (size_t i = 0; i < handlerManager.registeredCount(); ++i)
         {
-            if (entries[i].name && std::strcmp(entries[i].name, name) == 0)
+            HandlerEntry *e = handlerManager.handlerAt(i);
+            if (e->name && std::strcmp(e->name, name) == 0)
             {
-                entries[i].setEnabled(false);
+                e->setEnabled(false);
                 return true;
             }
         }
@@ -184,15 +287,12 @@ namespace LogAnywhere
     // Enable by ID
     inline bool enableHandler(uint16_t id)
     {
-        size_t count = 0;
-        HandlerEntry *entries = const_cast<HandlerEntry *>(
-            handlerManager.listHandlers(count));
-
-        for (size_t i = 0; i < count; ++i)
+        for (size_t i = 0; i < handlerManager.registeredCount(); ++i)
         {
-            if (entries[i].id == id)
+            HandlerEntry *e = handlerManager.handlerAt(i);
+            if (e->id == id)
             {
-                entries[i].setEnabled(true);
+                e->setEnabled(true);
                 return true;
             }
         }
@@ -201,15 +301,12 @@ namespace LogAnywhere
 
     inline bool disableHandler(uint16_t id)
     {
-        size_t count = 0;
-        HandlerEntry *entries = const_cast<HandlerEntry *>(
-            handlerManager.listHandlers(count));
-
-        for (size_t i = 0; i < count; ++i)
+        for (size_t i = 0; i < handlerManager.registeredCount(); ++i)
         {
-            if (entries[i].id == id)
+            HandlerEntry *e = handlerManager.handlerAt(i);
+            if (e->id == id)
             {
-                entries[i].setEnabled(false);
+                e->setEnabled(false);
                 return true;
             }
         }
@@ -8,6 +8,7 @@
  * along with a helper function to convert levels to human-readable strings.
  */
 
+#include <cstddef>
 #include <cstdint>
 
 namespace LogAnywhere {
@@ -26,6 +27,9 @@ namespace LogAnywhere {
         ERR       ///< Serious issues requiring attention
     };
 
+    /// Number of LogLevel values (TRACE..ERR).
+    constexpr size_t LOG_LEVEL_COUNT = static_cast<size_t>(LogLevel::ERR) + 1;
+
     /**
      * @brief Converts a `LogLevel` enum to a human-readable string.
      *
@@ -6,13 +6,30 @@
  *
  * A `LogMessage` contains all the core information about a log event, including
  * its severity, origin (tag), content, and optionally, a timestamp.
+ *
+ * The origin is given twice: `tagId` is the Tag's dense registry ID (see
+ * TagRegistry.h), which sinks can compare, index arrays with or store in
+ * binary records; `tag` is the Tag's name, the same string tagName(tagId)
+ * returns.  Messages built without a Tag have tagId 0.
+ *
+ * With LOGANYWHERE_ENABLE_ORIGIN the message also records which thread and
+ * CPU emitted it; Logger fills both from per-thread caches (see
+ * ThreadContext.h), so no system call is made per message.
  */
 
 #include <cstdint>
 #include "LogLevel.h"
 
+/// Record the emitting thread and CPU in every LogMessage.
+#ifndef LOGANYWHERE_ENABLE_ORIGIN
+#define LOGANYWHERE_ENABLE_ORIGIN 0
+#endif
+
 namespace LogAnywhere {
 
+    /// LogMessage::cpuId when the CPU could not be determined.
+    static constexpr uint32_t UNKNOWN_CPU = UINT32_MAX;
+
     struct LogMessage {
 
         LogMessage() = default; ///< Default constructor
@@ -22,15 +39,22 @@ namespace LogAnywhere {
         const char*  tag;        ///< Subsystem or component name
         const char*  message;    ///< Already-formatted message string
         uint64_t     timestamp;  ///< Optional timestamp
+        uint16_t     tagId = 0;  ///< Dense ID of the Tag (Tag::id), 0 if none
+#if LOGANYWHERE_ENABLE_ORIGIN
+        uint32_t     threadId = 0;           ///< OS thread ID of the emitter
+        uint32_t     cpuId = UNKNOWN_CPU;    ///< CPU the emitter ran on
+#endif
 
         constexpr LogMessage(LogLevel lvl,
                              const char* tg,
                              const char* msg,
-                             uint64_t ts = 0)
+                             uint64_t ts = 0,
+                             uint16_t id = 0)
           : level(lvl),
             tag(tg),
             message(msg),
-            timestamp(ts)
+            timestamp(ts),
+            tagId(id)
         {}
     };
 } // namespace LogAnywhere
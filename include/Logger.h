@@ -15,6 +15,15 @@
 #include <cstdarg>
 #include <cstdio>
 
+/// Format logf() output into a per-thread scratch buffer (see ThreadContext.h).
+#ifndef LOGANYWHERE_ENABLE_THREAD_CONTEXT
+#define LOGANYWHERE_ENABLE_THREAD_CONTEXT 0
+#endif
+
+#if LOGANYWHERE_ENABLE_THREAD_CONTEXT || LOGANYWHERE_ENABLE_ORIGIN
+#include "ThreadContext.h"
+#endif
+
 namespace LogAnywhere
 {
 
@@ -81,8 +90,9 @@ namespace LogAnywhere
         /**
          * @brief Logs a printf-style formatted message via a Tag*.
          *
-         * Formats into a fixed 256-byte stack buffer, then dispatches exactly as
-         * `log()`.
+         * Formats into a fixed 256-byte stack buffer (or the thread's scratch
+         * buffer with LOGANYWHERE_ENABLE_THREAD_CONTEXT), then dispatches
+         * exactly as `log()`.
          *
          * @param level Severity level of this message.
          * @param tag   Tag* to dispatch against.
@@ -93,6 +103,19 @@ namespace LogAnywhere
                   const Tag *tag,
                   const char *fmt, ...) const;
 
+        /**
+         * @brief va_list form of logf().
+         *
+         * @param level Severity level of this message.
+         * @param tag   Tag* to dispatch against.
+         * @param fmt   printf-style format string.
+         * @param args  Format arguments.
+         */
+        void vlogf(LogLevel level,
+                   const Tag *tag,
+                   const char *fmt,
+                   va_list args) const;
+
     private:
         const HandlerManager *handlerManager; ///< Where to look up handlers
         TimestampFn timestampProvider;        ///< User-supplied timestamp fn
@@ -156,8 +179,10 @@ namespace LogAnywhere
     /**
      * @brief Builds a LogMessage object from primitive inputs.
      *
-     * Populates a @c LogMessage with level, tag name, message content,
-     * and a timestamp chosen via @c chooseTimestamp().
+     * Populates a @c LogMessage with level, tag name and ID, message
+     * content, and a timestamp chosen via @c chooseTimestamp().  With
+     * LOGANYWHERE_ENABLE_ORIGIN it also stamps the cached thread ID and
+     * the current CPU.
      *
      * @param level      Severity level for this message
      * @param tag        Pointer to the Tag this message belongs to
@@ -170,17 +195,32 @@ namespace LogAnywhere
                                           const char *message,
                                           uint64_t explicitTs) const
     {
-        return LogMessage(level,
-                          tag->name,
-                          message,
-                          chooseTimestamp(explicitTs));
+        LogMessage msg(level,
+                       tag->name,
+                       message,
+                       chooseTimestamp(explicitTs),
+                       tag->id);
+#if LOGANYWHERE_ENABLE_ORIGIN
+        msg.threadId = static_cast<uint32_t>(contextThreadId());
+        msg.cpuId = currentCpu();
+#endif
+        return msg;
     }
 
     /**
      * @brief Sends a LogMessage to every enabled handler subscribed to a Tag.
      *
-     * Iterates through the Tag’s subscriber list and invokes each handler
-     * whose severity threshold is met.
+     * Walks the Tag's precomputed dispatch list for @p msg's level (the
+     * first levelEnd[level] rows of Tag::columns()), which holds exactly
+     * the enabled handlers whose threshold is met, so no level or enable
+     * test runs per handler.  Handler groups stay dynamic: the group mask
+     * is loaded once per message and, only if it disables a group used on
+     * this Tag, tested with one AND per handler.
+     *
+     * With LOGANYWHERE_ENABLE_HANDLER_LATENCY each call is timed into the
+     * entry's latency histogram; with LOGANYWHERE_ENABLE_STATS every
+     * delivery is counted in the calling thread's stats shard, and the
+     * rows past the list are walked to count skips by level or disable.
      *
      * @param msg The LogMessage to dispatch
      * @param tag The Tag whose handlers will receive @p msg
@@ -188,16 +228,46 @@ namespace LogAnywhere
     inline void Logger::dispatchToHandlers(const LogMessage &msg,
                                            const Tag *tag) const
     {
-        for (size_t i = 0; i < tag->handlerCount; ++i)
+#if LOGANYWHERE_ENABLE_STATS
+        const size_t shardIndex = statsShardIndex();
+        auto &shard = handlerManager->routingStats.shard(shardIndex);
+        shard.logged[static_cast<size_t>(msg.level)].fetch_add(1, std::memory_order_relaxed);
+        tag->logged.add(shardIndex, msg.level);
+#endif
+        const HandlerGroups disabledGroups = ~handlerManager->enabledGroupMask.load(std::memory_order_relaxed);
+        const bool checkGroups = (tag->dispatchGroups & disabledGroups) != 0;
+        const SubscriberColumns hot = tag->columns();
+        const size_t end = tag->levelEnd[static_cast<size_t>(msg.level)];
+        for (size_t i = 0; i < end; ++i)
         {
-            const HandlerEntry *e = tag->handlers[i];
-            if (!e->isEnabled())
+            if (checkGroups && (hot.groups[i] & disabledGroups))
+            {
+#if LOGANYWHERE_ENABLE_STATS
+                RoutingStats::countDroppedByDisabled(shard, hot.entries[i]->counters, shardIndex);
+#endif
                 continue;
-            if (static_cast<uint8_t>(msg.level) <
-                static_cast<uint8_t>(e->level))
-                continue;
-            e->handler(msg, e->context);
+            }
+#if LOGANYWHERE_ENABLE_STATS
+            RoutingStats::countDelivered(shard, hot.entries[i]->counters, shardIndex);
+#endif
+#if LOGANYWHERE_ENABLE_HANDLER_LATENCY
+            uint64_t start = LOGANYWHERE_LATENCY_NOW();
+            hot.fns[i](msg, hot.contexts[i]);
+            hot.entries[i]->latency.record(LOGANYWHERE_LATENCY_NOW() - start);
+#else
+            hot.fns[i](msg, hot.contexts[i]);
+#endif
         }
+#if LOGANYWHERE_ENABLE_STATS
+        for (size_t i = end, n = tag->dispatchRows; i < n; ++i)
+        {
+            const HandlerEntry *e = hot.entries[i];
+            if (!e->isEnabled() || (hot.groups[i] & disabledGroups))
+                RoutingStats::countDroppedByDisabled(shard, e->counters, shardIndex);
+            else
+                RoutingStats::countDroppedByLevel(shard, e->counters, shardIndex);
+        }
+#endif
     }
 
     /**
@@ -237,11 +307,40 @@ namespace LogAnywhere
                              const Tag *tag,
                              const char *fmt, ...) const
     {
-        char buffer[256];
         va_list args;
         va_start(args, fmt);
-        vsnprintf(buffer, sizeof(buffer), fmt, args);
+        vlogf(level, tag, fmt, args);
         va_end(args);
+    }
+
+    /**
+     * @brief Formats @p args and dispatches the result through log().
+     *
+     * With LOGANYWHERE_ENABLE_THREAD_CONTEXT the text goes into the calling
+     * thread's scratch buffer; a nested call (a handler logging) or a call
+     * after the thread's context was destroyed uses the stack buffer.
+     *
+     * @param level Severity level of this message
+     * @param tag   Tag* to dispatch against
+     * @param fmt   printf-style format string
+     * @param args  Format arguments
+     */
+    inline void Logger::vlogf(LogLevel level,
+                              const Tag *tag,
+                              const char *fmt,
+                              va_list args) const
+    {
+#if LOGANYWHERE_ENABLE_THREAD_CONTEXT
+        ScratchLease scratch;
+        if (char *buffer = scratch.data())
+        {
+            vsnprintf(buffer, ScratchLease::size(), fmt, args);
+            log(level, tag, buffer);
+            return;
+        }
+#endif
+        char buffer[256];
+        vsnprintf(buffer, sizeof(buffer), fmt, args);
         log(level, tag, buffer);
     }
 }
\ No newline at end of file
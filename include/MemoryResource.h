@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file MemoryResource.h
+ * @brief Minimal user-supplied allocator interface for growable storage.
+ *
+ * LogAnywhere never allocates on its own.  Components that may grow (the
+ * growable HandlerManager mode) take a MemoryResource: two function
+ * pointers plus a context, so any allocator can be plugged in without
+ * virtual calls or the STL.  ArenaResource is a ready-made bump allocator
+ * over a caller buffer; PmrResource.h adapts std::pmr::memory_resource.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Allocator hooks used by growable containers.
+     */
+    struct MemoryResource
+    {
+        /// Returns @p bytes of storage aligned to @p alignment, or nullptr.
+        void *(*allocate)(size_t bytes, size_t alignment, void *context);
+        /// Releases storage from allocate() (may be a no-op, e.g. for arenas).
+        void (*deallocate)(void *p, size_t bytes, size_t alignment, void *context);
+        /// User data passed to both hooks.
+        void *context;
+
+        void *allocateBytes(size_t bytes, size_t alignment) const
+        {
+            return allocate ? allocate(bytes, alignment, context) : nullptr;
+        }
+
+        void deallocateBytes(void *p, size_t bytes, size_t alignment) const
+        {
+            if (p && deallocate)
+                deallocate(p, bytes, alignment, context);
+        }
+    };
+
+    /**
+     * @brief Bump allocator over a caller-provided buffer.
+     *
+     * Deallocation is a no-op; memory is reclaimed all at once with reset().
+     * Not thread-safe: share one arena only between callers that are
+     * already serialized (HandlerManager registration is).
+     */
+    class ArenaResource
+    {
+    public:
+        /**
+         * @param buffer Storage to carve allocations from.
+         * @param size   Size of @p buffer in bytes.
+         */
+        ArenaResource(void *buffer, size_t size)
+            : base(static_cast<uint8_t *>(buffer)), capacity(size), offset(0)
+        {
+        }
+
+        /// @return A MemoryResource drawing from this arena.
+        MemoryResource resource() { return MemoryResource{allocateHook, deallocateHook, this}; }
+
+        /// @return Bytes handed out so far, including alignment padding.
+        size_t used() const noexcept { return offset; }
+
+        /// @return Bytes still available (before alignment).
+        size_t remaining() const noexcept { return capacity - offset; }
+
+        /// Forgets every allocation.  Only safe once nothing uses the memory.
+        void reset() noexcept { offset = 0; }
+
+    private:
+        uint8_t *base;
+        size_t capacity;
+        size_t offset;
+
+        static void *allocateHook(size_t bytes, size_t alignment, void *context)
+        {
+            auto *arena = static_cast<ArenaResource *>(context);
+            uintptr_t start = reinterpret_cast<uintptr_t>(arena->base) + arena->offset;
+            uintptr_t aligned = (start + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            size_t needed = static_cast<size_t>(aligned - start) + bytes;
+            if (needed > arena->capacity - arena->offset)
+                return nullptr;
+            arena->offset += needed;
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        static void deallocateHook(void *, size_t, size_t, void *) {}
+    };
+
+} // namespace LogAnywhere
@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file MessageRing.h
+ * @brief Bounded lock-free ring of deep-copied LogMessages.
+ *
+ * The building block of the async queues (PerCpuRing, HandlerExecutor):
+ * any number of producers claim slots with one compare-and-swap on the
+ * tail, and one consumer at a time reads the head.  Each slot carries a
+ * sequence number (position when free, position + 1 once committed), so a
+ * producer that is preempted mid-write only holds back its own slot and
+ * nobody ever waits on a lock.
+ *
+ * A full ring rejects and counts new records.  Message text is copied
+ * into the slot, truncated to fit, and handed to the consumer in place.
+ * A message from a registered Tag keeps only its tagId; the name is looked
+ * up again (tagName()) when the record is consumed, so the whole slot text
+ * is left for the message; such Tags must outlive their queued records.
+ * Other messages copy the tag name as well.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "LogMessage.h"
+#include "HandlerEntry.h"
+#include "TagRegistry.h"
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Multi-producer, single-consumer ring of LogMessage copies.
+     *
+     * @tparam SLOTS Slot count (power of two).
+     * @tparam TEXT  Bytes per slot for tag and message text, including
+     *               both terminators.
+     */
+    template <size_t SLOTS, size_t TEXT>
+    class alignas(64) MessageRing
+    {
+    public:
+        static_assert(SLOTS > 1 && (SLOTS & (SLOTS - 1)) == 0, "ring slots must be a power of two");
+        static_assert(TEXT >= 2 && TEXT <= 65536, "slot text must hold two terminators");
+
+        MessageRing()
+        {
+            for (size_t i = 0; i < SLOTS; ++i)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MessageRing(const MessageRing &) = delete;
+        MessageRing &operator=(const MessageRing &) = delete;
+
+        /**
+         * @brief Copies @p msg into the next free slot.  Lock-free.
+         *
+         * @param msg Message to enqueue.
+         * @return false if the ring was full and the message was dropped.
+         */
+        bool push(const LogMessage &msg)
+        {
+            uint64_t pos = tail.load(std::memory_order_relaxed);
+            Slot *slot;
+            for (;;)
+            {
+                slot = &slots[pos & (SLOTS - 1)];
+                const uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+                const int64_t diff = static_cast<int64_t>(seq - pos);
+                if (diff == 0)
+                {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+            fill(*slot, msg);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks whether the head record is committed.  Consumer only.
+         *
+         * @param timestamp Set to the head record's timestamp if ready.
+         * @return true if pop() would deliver a record.
+         */
+        bool ready(uint64_t &timestamp) const
+        {
+            const Slot &s = slots[head & (SLOTS - 1)];
+            if (s.sequence.load(std::memory_order_acquire) != head + 1)
+                return false;
+            timestamp = s.timestamp;
+            return true;
+        }
+
+        /**
+         * @brief Hands the head record to @p sink and frees its slot.  Consumer only.
+         *
+         * The LogMessage points into the slot and is valid only during the call.
+         *
+         * @param sink Called with the record.
+         * @param ctx  Passed through to @p sink.
+         * @return false if the head record is not committed yet.
+         */
+        bool pop(LogHandler sink, void *ctx)
+        {
+            Slot &s = slots[head & (SLOTS - 1)];
+            if (s.sequence.load(std::memory_order_acquire) != head + 1)
+                return false;
+            sink(messageOf(s), ctx);
+            s.sequence.store(head + SLOTS, std::memory_order_release);
+            ++head;
+            return true;
+        }
+
+        /// @return Position of the next record to consume (consumer only).
+        uint64_t readPosition() const noexcept { return head; }
+
+        /**
+         * @brief Checks for records claimed at or after @p position.
+         *
+         * Reads only the atomic tail, so it is safe after the consumer role
+         * has been handed to another thread.
+         */
+        bool pushedSince(uint64_t position) const noexcept
+        {
+            return tail.load(std::memory_order_acquire) != position;
+        }
+
+        /// @return Messages dropped because the ring was full.
+        uint64_t dropped() const noexcept { return droppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        /// One queued record; text holds "tag\0message\0" ("\0message\0" with a tagId).
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence; ///< == position: free; position + 1: committed
+            uint64_t timestamp;
+#if LOGANYWHERE_ENABLE_ORIGIN
+            uint32_t threadId;
+            uint32_t cpuId;
+#endif
+            LogLevel level;
+            uint16_t tagId;  ///< Non-zero: tag name is not stored (tagLen 0)
+            uint16_t tagLen;
+            char text[TEXT];
+        };
+
+        std::atomic<uint64_t> tail{0};         ///< Next position to claim
+        std::atomic<uint64_t> droppedCount{0}; ///< Rejected because full
+        alignas(64) uint64_t head = 0;         ///< Next position to consume (consumer only)
+        Slot slots[SLOTS];
+
+        /// Deep-copies @p msg into @p slot, truncating text to fit.
+        static void fill(Slot &slot, const LogMessage &msg)
+        {
+            slot.timestamp = msg.timestamp;
+            slot.level = msg.level;
+#if LOGANYWHERE_ENABLE_ORIGIN
+            slot.threadId = msg.threadId;
+            slot.cpuId = msg.cpuId;
+#endif
+            slot.tagId = msg.tagId;
+            const size_t tagLen = copyText(slot.text, msg.tagId ? nullptr : msg.tag, TEXT / 2 - 1);
+            slot.tagLen = static_cast<uint16_t>(tagLen);
+            copyText(slot.text + tagLen + 1, msg.message, TEXT - tagLen - 2);
+        }
+
+        /// Copies at most @p max bytes of @p src plus a terminator; @return bytes copied.
+        static size_t copyText(char *dst, const char *src, size_t max)
+        {
+            size_t n = src ? std::strlen(src) : 0;
+            if (n > max)
+                n = max;
+            std::memcpy(dst, src ? src : "", n);
+            dst[n] = '\0';
+            return n;
+        }
+
+        /// @return A LogMessage viewing @p slot.
+        static LogMessage messageOf(const Slot &slot)
+        {
+            const char *tag = slot.tagId ? tagName(slot.tagId) : nullptr;
+            LogMessage msg(slot.level, tag ? tag : slot.text, slot.text + slot.tagLen + 1,
+                           slot.timestamp, slot.tagId);
+#if LOGANYWHERE_ENABLE_ORIGIN
+            msg.threadId = slot.threadId;
+            msg.cpuId = slot.cpuId;
+#endif
+            return msg;
+        }
+    };
+
+} // namespace LogAnywhere
@@ -0,0 +1,423 @@
+#pragma once
+
+/**
+ * @file NumaQueue.h
+ * @brief NUMA-aware async queue: node-local rings and one consumer per node.
+ *
+ * On multi-socket hosts a producer writing into memory that lives on the
+ * other socket pays cross-socket traffic for every record.  NumaQueue keeps
+ * one PerCpuRing per NUMA node:
+ *
+ *  - each node's ring set is mapped untouched and then constructed by a
+ *    thread pinned to that node's CPUs, so first-touch places its pages
+ *    on that node;
+ *  - push() looks up the calling CPU's node and appends to that node's
+ *    rings, so producers only write node-local memory;
+ *  - by default one consumer per node (also pinned there) drains its own
+ *    rings into the sink, which must then be thread-safe; with
+ *    mergeNodes = true a single consumer merges all nodes by timestamp,
+ *    for sinks that need one ordered stream.
+ *
+ * NumaTopology reads the CPU → node map from sysfs, so libnuma is not
+ * needed.  Hosts without NUMA information are treated as one node, and
+ * tests can describe any layout with NumaTopology::assign().
+ *
+ * Only available on Linux (sysfs, CPU affinity, mmap).
+ */
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "PerCpuRing.h"
+
+/// Largest number of NUMA nodes NumaTopology and NumaQueue track.
+#ifndef LOGANYWHERE_NUMA_MAX_NODES
+#define LOGANYWHERE_NUMA_MAX_NODES 8
+#endif
+
+/// Microseconds an idle NumaQueue consumer sleeps between polls.
+#ifndef LOGANYWHERE_NUMA_IDLE_US
+#define LOGANYWHERE_NUMA_IDLE_US 200
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Maps CPUs to NUMA nodes (dense node indices 0 .. nodeCount()-1).
+     */
+    class NumaTopology
+    {
+    public:
+        static constexpr size_t MAX_NODES = LOGANYWHERE_NUMA_MAX_NODES; ///< Node capacity
+        static constexpr size_t MAX_CPUS = CPU_SETSIZE;                 ///< CPU capacity
+
+        /// An empty topology; add CPUs with assign().
+        NumaTopology()
+        {
+            std::memset(cpuNode, NONE, sizeof(cpuNode));
+        }
+
+        /**
+         * @brief Reads the host topology from /sys/devices/system/node.
+         *
+         * Nodes without CPUs are skipped.  If nothing can be read, all CPUs
+         * form a single node.
+         *
+         * @return The topology.
+         */
+        static NumaTopology detect()
+        {
+            NumaTopology t;
+            char path[64];
+            char list[512];
+            for (unsigned id = 0; id < 1024 && t.nodes < MAX_NODES; ++id)
+            {
+                std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", id);
+                if (!readFile(path, list, sizeof(list)))
+                    continue;
+                // assign() grows t.nodes when this node lists any CPU
+                parseCpuList(list, assignTo, &t, t.nodes);
+            }
+            if (t.nodes == 0)
+                return singleNode();
+            return t;
+        }
+
+        /**
+         * @brief A one-node topology holding every configured CPU.
+         * @return The topology.
+         */
+        static NumaTopology singleNode()
+        {
+            NumaTopology t;
+            long cpus = sysconf(_SC_NPROCESSORS_CONF);
+            if (cpus < 1)
+                cpus = 1;
+            for (long cpu = 0; cpu < cpus && static_cast<size_t>(cpu) < MAX_CPUS; ++cpu)
+                t.assign(static_cast<size_t>(cpu), 0);
+            return t;
+        }
+
+        /**
+         * @brief Places @p cpu on @p node (builds custom or emulated layouts).
+         *
+         * @param cpu  CPU number, < MAX_CPUS.
+         * @param node Dense node index, < MAX_NODES.
+         * @return false if either index is out of range.
+         */
+        bool assign(size_t cpu, size_t node)
+        {
+            if (cpu >= MAX_CPUS || node >= MAX_NODES)
+                return false;
+            if (cpuNode[cpu] != NONE)
+                CPU_CLR(cpu, &nodeCpus[cpuNode[cpu]]);
+            cpuNode[cpu] = static_cast<uint8_t>(node);
+            CPU_SET(cpu, &nodeCpus[node]);
+            if (node >= nodes)
+                nodes = node + 1;
+            return true;
+        }
+
+        /// @return Number of nodes (at least 1 once built).
+        size_t nodeCount() const noexcept { return nodes; }
+
+        /**
+         * @brief Node of a CPU.
+         * @param cpu CPU number (e.g. from currentCpu()).
+         * @return Its node, or 0 for unknown CPUs.
+         */
+        size_t nodeOf(uint32_t cpu) const noexcept
+        {
+            return cpu < MAX_CPUS && cpuNode[cpu] != NONE ? cpuNode[cpu] : 0;
+        }
+
+        /// @return The CPUs of @p node, for pinning threads there.
+        const cpu_set_t &cpusOf(size_t node) const noexcept { return nodeCpus[node]; }
+
+        /**
+         * @brief Parses a sysfs CPU list such as "0-3,8,10-11".
+         *
+         * @param list   The text; parsing stops at a newline or the end.
+         * @param fn     Called with each CPU number.
+         * @param ctx    Passed to @p fn.
+         * @param node   Passed to @p fn.
+         * @return true if at least one CPU was listed.
+         */
+        static bool parseCpuList(const char *list,
+                                 void (*fn)(void *ctx, size_t cpu, size_t node),
+                                 void *ctx,
+                                 size_t node)
+        {
+            bool any = false;
+            const char *p = list;
+            while (*p >= '0' && *p <= '9')
+            {
+                char *end;
+                const unsigned long first = std::strtoul(p, &end, 10);
+                unsigned long last = first;
+                if (*end == '-')
+                    last = std::strtoul(end + 1, &end, 10);
+                for (unsigned long cpu = first; cpu <= last && cpu < MAX_CPUS; ++cpu)
+                {
+                    fn(ctx, cpu, node);
+                    any = true;
+                }
+                p = *end == ',' ? end + 1 : end;
+            }
+            return any;
+        }
+
+    private:
+        static constexpr uint8_t NONE = 0xFF; ///< cpuNode[] value for CPUs not placed yet
+        static_assert(MAX_NODES < NONE, "node index must fit below the NONE marker");
+
+        uint8_t cpuNode[MAX_CPUS];          ///< Node per CPU, NONE if not placed
+        cpu_set_t nodeCpus[MAX_NODES] = {}; ///< CPUs per node
+        size_t nodes = 0;                   ///< Nodes in use
+
+        static void assignTo(void *ctx, size_t cpu, size_t node)
+        {
+            static_cast<NumaTopology *>(ctx)->assign(cpu, node);
+        }
+
+        static bool readFile(const char *path, char *buf, size_t cap)
+        {
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return false;
+            const ssize_t n = ::read(fd, buf, cap - 1);
+            ::close(fd);
+            if (n <= 0)
+                return false;
+            buf[n] = '\0';
+            return true;
+        }
+    };
+
+    /**
+     * @brief Async queue with node-local rings and per-node consumers.
+     */
+    class NumaQueue
+    {
+    public:
+        static constexpr size_t MAX_NODES = NumaTopology::MAX_NODES; ///< Node capacity
+
+        NumaQueue() = default;
+        ~NumaQueue() { stop(); release(); }
+
+        NumaQueue(const NumaQueue &) = delete;
+        NumaQueue &operator=(const NumaQueue &) = delete;
+
+        /**
+         * @brief Allocates node-local rings and starts the consumers.
+         *
+         * Returns once every node's rings exist, so push() may be called
+         * right away.  A queue is started once; its rings live until it is
+         * destroyed.
+         *
+         * @param topology   CPU → node map (see NumaTopology::detect()).
+         * @param sink       Receives every record.
+         * @param ctx        Passed through to @p sink.
+         * @param mergeNodes false: one consumer per node calls @p sink
+         *                   concurrently; true: one consumer merges all nodes
+         *                   by timestamp and is the only caller of @p sink.
+         * @return false if already running or memory could not be mapped.
+         */
+        bool start(const NumaTopology &topology, LogHandler sink, void *ctx, bool mergeNodes = false)
+        {
+            if (running.load(std::memory_order_relaxed) || nodeCount != 0)
+                return false;
+            topo = topology;
+            sinkFn = sink;
+            sinkCtx = ctx;
+            merged = mergeNodes;
+            const size_t nodes = topo.nodeCount() ? topo.nodeCount() : 1;
+            for (size_t n = 0; n < nodes; ++n)
+            {
+                void *mem = mmap(nullptr, sizeof(PerCpuRing), PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (mem == MAP_FAILED)
+                {
+                    release();
+                    return false;
+                }
+                memory[n] = mem;
+                ++nodeCount;
+            }
+
+            running.store(true, std::memory_order_relaxed);
+            ready.store(0, std::memory_order_relaxed);
+            for (size_t n = 0; n < nodeCount; ++n)
+                workers[n] = std::thread(&NumaQueue::nodeMain, this, n);
+            while (ready.load(std::memory_order_acquire) != nodeCount)
+                std::this_thread::yield();
+            if (merged)
+                mergeWorker = std::thread(&NumaQueue::mergeMain, this);
+            return true;
+        }
+
+        /**
+         * @brief Stops the consumers after they drain what is queued.
+         *
+         * Producers must have stopped pushing.  The rings stay mapped until
+         * the queue is destroyed, so a late push() is harmless.
+         */
+        void stop()
+        {
+            if (!running.exchange(false))
+                return;
+            for (size_t n = 0; n < nodeCount; ++n)
+                workers[n].join();
+            if (mergeWorker.joinable())
+                mergeWorker.join();
+        }
+
+        /**
+         * @brief Copies @p msg into the calling CPU's node-local rings.
+         *
+         * @param msg Message to enqueue (deep copy).
+         * @return false if the queue is not started or the ring was full.
+         */
+        bool push(const LogMessage &msg)
+        {
+            const uint32_t cpu = currentCpu();
+            return push(msg, topo.nodeOf(cpu));
+        }
+
+        /**
+         * @brief Copies @p msg into the rings of a given node.
+         *
+         * @param msg  Message to enqueue.
+         * @param node Node index.
+         * @return false if the queue is not started, @p node is unknown or
+         *         the ring was full.
+         */
+        bool push(const LogMessage &msg, size_t node)
+        {
+            if (node >= nodeCount || !rings[node])
+                return false;
+            return rings[node]->push(msg);
+        }
+
+        /// @return Nodes with their own rings.
+        size_t nodes() const noexcept { return nodeCount; }
+
+        /// @return Messages dropped because a ring was full.
+        uint64_t dropped() const noexcept
+        {
+            uint64_t total = 0;
+            for (size_t n = 0; n < nodeCount; ++n)
+                total += rings[n] ? rings[n]->dropped() : 0;
+            return total;
+        }
+
+        /**
+         * @brief LogHandler adapter: register with a NumaQueue* context.
+         */
+        static void logHandler(const LogMessage &msg, void *context)
+        {
+            static_cast<NumaQueue *>(context)->push(msg);
+        }
+
+    private:
+        NumaTopology topo;
+        LogHandler sinkFn = nullptr;
+        void *sinkCtx = nullptr;
+        bool merged = false;
+        size_t nodeCount = 0;
+        void *memory[MAX_NODES] = {};           ///< mmap'd storage per node
+        PerCpuRing *rings[MAX_NODES] = {};      ///< Constructed in memory[] on its node
+        std::thread workers[MAX_NODES];         ///< Per-node placement / consumer threads
+        std::thread mergeWorker;                ///< Single consumer when merged
+        std::atomic<bool> running{false};
+        std::atomic<size_t> ready{0};           ///< Nodes whose rings are constructed
+
+        static void idle()
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(LOGANYWHERE_NUMA_IDLE_US));
+        }
+
+        /// Runs on node @p n: first-touches its rings, then drains them unless merged.
+        void nodeMain(size_t n)
+        {
+            // Best effort: emulated nodes may name CPUs this host lacks
+            const cpu_set_t &cpus = topo.cpusOf(n);
+            if (CPU_COUNT(&cpus) > 0)
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus);
+            rings[n] = new (memory[n]) PerCpuRing();
+            ready.fetch_add(1, std::memory_order_release);
+            if (merged)
+                return;
+            while (running.load(std::memory_order_relaxed))
+            {
+                if (rings[n]->drain(sinkFn, sinkCtx) == 0)
+                    idle();
+            }
+            rings[n]->drain(sinkFn, sinkCtx);
+        }
+
+        /// Single consumer: repeatedly delivers the oldest ready record of any node.
+        void mergeMain()
+        {
+            for (;;)
+            {
+                const bool stopping = !running.load(std::memory_order_acquire);
+                size_t delivered = 0;
+                for (;;)
+                {
+                    PerCpuRing *best = nullptr;
+                    uint64_t bestTs = 0;
+                    for (size_t n = 0; n < nodeCount; ++n)
+                    {
+                        uint64_t ts;
+                        if (rings[n]->oldestTimestamp(ts) && (!best || ts < bestTs))
+                        {
+                            best = rings[n];
+                            bestTs = ts;
+                        }
+                    }
+                    if (!best)
+                        break;
+                    delivered += best->drain(sinkFn, sinkCtx, 1);
+                }
+                if (stopping)
+                    return;
+                if (delivered == 0)
+                    idle();
+            }
+        }
+
+        /// Unmaps every node's storage.
+        void release()
+        {
+            for (size_t n = 0; n < nodeCount; ++n)
+            {
+                if (rings[n])
+                    rings[n]->~PerCpuRing();
+                rings[n] = nullptr;
+                if (memory[n])
+                    munmap(memory[n], sizeof(PerCpuRing));
+                memory[n] = nullptr;
+            }
+            nodeCount = 0;
+        }
+    };
+
+} // namespace LogAnywhere
+
+#endif // __linux__
@@ -0,0 +1,188 @@
+#pragma once
+
+/**
+ * @file PerCpuRing.h
+ * @brief Async log queue with one ring per CPU and a merging consumer.
+ *
+ * Per-thread queues cost memory for every thread, which adds up in services
+ * with large thread pools.  PerCpuRing keeps one bounded ring per CPU
+ * instead, so memory scales with cores:
+ *
+ *  - a producer reads its CPU from rseq (see currentCpu()) and appends to
+ *    that CPU's ring; the slot is claimed with one compare-and-swap, so a
+ *    producer that is preempted or migrates mid-write still owns its slot
+ *    and never blocks anyone else;
+ *  - records are deep copies (tag and message text live in the slot), so
+ *    the caller's buffers can be reused as soon as push() returns;
+ *  - one consumer drains all rings, merging their heads by timestamp, and
+ *    hands each record to a LogHandler while it is still in the slot.
+ *
+ * A full ring drops the new record and counts it; producers never wait.
+ * Register logHandler() on the Tags that should go async, and call drain()
+ * from the thread that runs the slow sinks.
+ *
+ * @code
+ * static PerCpuRing queue;
+ * mgr.registerHandlerForTags(LogLevel::INFO, PerCpuRing::logHandler, &queue, tags, n);
+ * // consumer thread:
+ * while (running) queue.drain(writeToSocket, &sock);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MessageRing.h"
+#include "ThreadContext.h"
+
+/// Number of rings; CPU n appends to ring n % LOGANYWHERE_PERCPU_RINGS.
+#ifndef LOGANYWHERE_PERCPU_RINGS
+#define LOGANYWHERE_PERCPU_RINGS 16
+#endif
+
+/// Slots per ring (power of two).
+#ifndef LOGANYWHERE_PERCPU_SLOTS
+#define LOGANYWHERE_PERCPU_SLOTS 64
+#endif
+
+/// Bytes per slot for tag and message text, including both terminators.
+#ifndef LOGANYWHERE_PERCPU_SLOT_TEXT
+#define LOGANYWHERE_PERCPU_SLOT_TEXT 128
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Bounded multi-producer, single-consumer queue with a ring per CPU.
+     */
+    class PerCpuRing
+    {
+    public:
+        static constexpr size_t RINGS = LOGANYWHERE_PERCPU_RINGS;          ///< Ring count
+        static constexpr size_t SLOTS = LOGANYWHERE_PERCPU_SLOTS;          ///< Slots per ring
+        static constexpr size_t SLOT_TEXT = LOGANYWHERE_PERCPU_SLOT_TEXT;  ///< Text bytes per slot
+        static_assert(RINGS > 0, "need at least one ring");
+
+        PerCpuRing() = default;
+
+        PerCpuRing(const PerCpuRing &) = delete;
+        PerCpuRing &operator=(const PerCpuRing &) = delete;
+
+        /**
+         * @brief Copies @p msg into the calling CPU's ring.
+         *
+         * Lock-free; safe from any number of threads.
+         *
+         * @param msg Message to enqueue; its strings are copied (truncated
+         *            to fit the slot).
+         * @return false if the ring was full and the message was dropped.
+         */
+        bool push(const LogMessage &msg)
+        {
+            const uint32_t cpu = currentCpu();
+            return push(msg, cpu == UNKNOWN_CPU ? 0 : cpu % RINGS);
+        }
+
+        /**
+         * @brief Copies @p msg into a specific ring.
+         *
+         * For producers that choose the ring themselves (e.g. by NUMA node).
+         *
+         * @param msg  Message to enqueue.
+         * @param ring Ring index, < RINGS.
+         * @return false if the ring was full and the message was dropped.
+         */
+        bool push(const LogMessage &msg, size_t ring)
+        {
+            return rings[ring].push(msg);
+        }
+
+        /**
+         * @brief Hands queued records to @p sink, oldest timestamp first.
+         *
+         * Single consumer only.  Each step takes the committed head with the
+         * lowest timestamp across all rings; a ring whose head is still
+         * being written is skipped until a later step.  The LogMessage
+         * points into the slot and is valid only during the @p sink call.
+         *
+         * @param sink        Called for each record.
+         * @param ctx         Passed through to @p sink.
+         * @param maxRecords  Stop after this many records.
+         * @return Number of records delivered.
+         */
+        size_t drain(LogHandler sink, void *ctx, size_t maxRecords = SIZE_MAX)
+        {
+            size_t delivered = 0;
+            uint64_t ts;
+            while (delivered < maxRecords)
+            {
+                Ring *best = oldestReady(ts);
+                if (!best)
+                    break;
+                best->pop(sink, ctx);
+                ++delivered;
+            }
+            return delivered;
+        }
+
+        /**
+         * @brief Peeks at the record drain() would deliver next.
+         *
+         * Consumer only; lets a caller merge several queues by timestamp.
+         *
+         * @param timestamp Set to that record's timestamp.
+         * @return false if no record is ready.
+         */
+        bool oldestTimestamp(uint64_t &timestamp)
+        {
+            return oldestReady(timestamp) != nullptr;
+        }
+
+        /// @return Messages dropped because their ring was full.
+        uint64_t dropped() const noexcept
+        {
+            uint64_t total = 0;
+            for (const Ring &r : rings)
+                total += r.dropped();
+            return total;
+        }
+
+        /// @return Messages dropped by ring @p ring.
+        uint64_t dropped(size_t ring) const noexcept
+        {
+            return rings[ring].dropped();
+        }
+
+        /**
+         * @brief LogHandler adapter: register with a PerCpuRing* context.
+         */
+        static void logHandler(const LogMessage &msg, void *context)
+        {
+            static_cast<PerCpuRing *>(context)->push(msg);
+        }
+
+    private:
+        using Ring = MessageRing<SLOTS, SLOT_TEXT>;
+
+        Ring rings[RINGS];
+
+        /// @return The ring whose committed head has the lowest timestamp
+        ///         (stored in @p timestamp), or nullptr.
+        Ring *oldestReady(uint64_t &timestamp)
+        {
+            Ring *best = nullptr;
+            for (Ring &r : rings)
+            {
+                uint64_t ts;
+                if (r.ready(ts) && (!best || ts < timestamp))
+                {
+                    best = &r;
+                    timestamp = ts;
+                }
+            }
+            return best;
+        }
+    };
+
+} // namespace LogAnywhere
@@ -0,0 +1,554 @@
+#pragma once
+
+/**
+ * @file PersistentRing.h
+ * @brief Crash-resilient, file-backed ring buffer with persistent record IDs.
+ *
+ * PersistentRing maps a file into memory and stores records in fixed-size
+ * slots.  Every slot holds one RecordFrame (magic, length, CRC32C, sync
+ * marker) whose payload starts with a monotonic 64-bit ID, and the record
+ * with ID n always lives in slot (n - 1) % slotCount.  Because IDs
+ * increase by one from slot to slot, recovery finds the newest valid record
+ * with a binary search (O(log n)); a torn final write simply fails its
+ * checksum and is discarded.  A persisted acknowledgement ID lets shippers
+ * resume exactly where they stopped after a crash or restart.
+ *
+ * Stores land in the shared page cache, so records survive a process crash
+ * without any flush; call sync() to also survive power loss.
+ *
+ * Only available on POSIX targets (mmap).  Not thread-safe: one writer.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "RecordFrame.h"
+#include "LogLevel.h"
+#include "LogMessage.h"
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief On-disk header at the start of a ring file (64 bytes).
+     */
+    struct PersistentRingHeader
+    {
+        uint32_t magic;       ///< PersistentRing::MAGIC
+        uint16_t version;     ///< Layout version
+        uint16_t headerSize;  ///< sizeof(PersistentRingHeader)
+        uint32_t slotCount;   ///< Number of slots in the ring
+        uint32_t slotSize;    ///< Bytes per slot, including slot header and frame trailer
+        uint64_t ackedId;     ///< Highest record ID acknowledged by a shipper
+        uint8_t reserved[40]; ///< Zero; room for future fields
+    };
+
+    /**
+     * @brief Header at the start of every slot (24 bytes).
+     *
+     * The slot is a RecordFrame whose payload is the record ID followed by
+     * the record bytes; the frame's sync marker follows the record.
+     */
+    struct PersistentSlotHeader
+    {
+        FrameHeader frame; ///< Frame header; frame.length covers id + record
+        uint64_t id;       ///< Record ID (0 = never written)
+    };
+
+    static_assert(sizeof(PersistentRingHeader) == 64, "PersistentRingHeader layout changed");
+    static_assert(sizeof(PersistentSlotHeader) == 24, "PersistentSlotHeader layout changed");
+
+    /**
+     * @brief Decoded view of a record written by PersistentRing::appendMessage().
+     *
+     * Pointers refer into the buffer passed to decodeMessage(); strings are
+     * not null-terminated.
+     */
+    struct PersistentLogRecord
+    {
+        LogLevel level;      ///< Severity level
+        uint64_t timestamp;  ///< Timestamp copied from the LogMessage
+        const char *tag;     ///< Tag name bytes
+        size_t tagLen;       ///< Length of tag
+        const char *message; ///< Message bytes
+        size_t messageLen;   ///< Length of message
+        uint32_t threadId;   ///< Emitting thread (0 if the record has no origin)
+        uint32_t cpuId;      ///< Emitting CPU (UNKNOWN_CPU if the record has no origin)
+    };
+
+    /**
+     * @brief Memory-mapped ring of checksummed, ID-stamped records.
+     */
+    class PersistentRing
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x4752414Cu;     ///< "LARG" little-endian
+        static constexpr uint16_t VERSION = 2;             ///< Current layout version (2 = framed slots)
+        static constexpr uint32_t DEFAULT_SLOT_SIZE = 256; ///< Default bytes per slot
+
+        PersistentRing()
+            : fd(-1), base(nullptr), mappedSize(0), header(nullptr),
+              slotCount(0), slotSize(0), first(1), last(0)
+        {
+        }
+
+        ~PersistentRing() { close(); }
+
+        PersistentRing(const PersistentRing &) = delete;
+        PersistentRing &operator=(const PersistentRing &) = delete;
+
+        /**
+         * @brief Opens or creates a ring file and recovers its state.
+         *
+         * A new file is sized and initialized; an existing file must have
+         * the same geometry, otherwise open fails and the file is untouched.
+         * A file of the right size whose header was never completed (the
+         * process died between sizing it and writing the magic, which is
+         * stored last) is initialized again.
+         *
+         * @param path       File to map.
+         * @param slots      Number of slots (≥ 1).
+         * @param bytesPerSlot Slot size including the 24-byte slot header and 4-byte trailer.
+         * @return true if the ring is ready for use.
+         */
+        bool open(const char *path, uint32_t slots, uint32_t bytesPerSlot = DEFAULT_SLOT_SIZE)
+        {
+            close();
+            if (slots == 0 || bytesPerSlot <= SLOT_OVERHEAD || bytesPerSlot % 8 != 0)
+                return false;
+
+            int f = ::open(path, O_RDWR | O_CREAT, 0644);
+            if (f < 0)
+                return false;
+
+            size_t total = sizeof(PersistentRingHeader) + static_cast<size_t>(slots) * bytesPerSlot;
+            struct stat st;
+            if (fstat(f, &st) != 0)
+            {
+                ::close(f);
+                return false;
+            }
+            bool fresh = (st.st_size == 0);
+            if (fresh && ftruncate(f, static_cast<off_t>(total)) != 0)
+            {
+                ::close(f);
+                return false;
+            }
+            if (!fresh && static_cast<size_t>(st.st_size) != total)
+            {
+                ::close(f);
+                return false;
+            }
+
+            void *m = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, f, 0);
+            if (m == MAP_FAILED)
+            {
+                ::close(f);
+                return false;
+            }
+
+            fd = f;
+            base = static_cast<uint8_t *>(m);
+            mappedSize = total;
+            header = reinterpret_cast<PersistentRingHeader *>(base);
+            slotCount = slots;
+            slotSize = bytesPerSlot;
+
+            if (!fresh && unfinishedHeader(slots, bytesPerSlot))
+            {
+                std::memset(base, 0, total);
+                fresh = true;
+            }
+
+            if (fresh)
+            {
+                std::memset(header, 0, sizeof(*header));
+                header->slotCount = slots;
+                header->slotSize = bytesPerSlot;
+                header->headerSize = sizeof(PersistentRingHeader);
+                header->version = VERSION;
+                std::atomic_signal_fence(std::memory_order_release);
+                header->magic = MAGIC;
+                first = 1;
+                last = 0;
+                return true;
+            }
+
+            if (header->magic != MAGIC || header->version != VERSION ||
+                header->slotCount != slots || header->slotSize != bytesPerSlot)
+            {
+                close();
+                return false;
+            }
+            recover();
+            return true;
+        }
+
+        /**
+         * @brief Unmaps the file and closes it.  Safe to call repeatedly.
+         */
+        void close()
+        {
+            if (base)
+                munmap(base, mappedSize);
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+            base = nullptr;
+            header = nullptr;
+            mappedSize = 0;
+            first = 1;
+            last = 0;
+        }
+
+        /// @return true while a file is mapped.
+        bool isOpen() const noexcept { return base != nullptr; }
+
+        /// @return Largest payload a single record can hold.
+        size_t maxPayload() const noexcept
+        {
+            return slotSize ? slotSize - SLOT_OVERHEAD : 0;
+        }
+
+        /// @return ID of the oldest record still in the ring (> lastId() when empty).
+        uint64_t firstId() const noexcept { return first; }
+
+        /// @return ID of the newest record, or 0 if nothing was ever written.
+        uint64_t lastId() const noexcept { return last; }
+
+        /**
+         * @brief Appends one record, overwriting the oldest when full.
+         *
+         * @param data Payload bytes.
+         * @param len  Payload length (must not exceed maxPayload()).
+         * @return The new record's ID, or 0 if closed or @p len is too large.
+         */
+        uint64_t append(const void *data, size_t len)
+        {
+            if (!base || len > maxPayload())
+                return 0;
+
+            uint8_t *payload = beginRecord();
+            std::memcpy(payload, data, len);
+            return commitRecord(len);
+        }
+
+        /**
+         * @brief Appends a LogMessage as a compact binary record.
+         *
+         * Layout: u64 timestamp, u8 level, u8 tag length, tag bytes, message
+         * bytes.  With LOGANYWHERE_ENABLE_ORIGIN the level byte has
+         * RECORD_HAS_ORIGIN set and u32 thread ID, u32 CPU follow the tag
+         * length.  The tag is clamped to 255 bytes and the message truncated
+         * to fit the slot.
+         *
+         * @param msg Message to persist.
+         * @return The new record's ID, or 0 on failure.
+         */
+        uint64_t appendMessage(const LogMessage &msg)
+        {
+#if LOGANYWHERE_ENABLE_ORIGIN
+            const size_t fixed = RECORD_FIXED + RECORD_ORIGIN;
+#else
+            const size_t fixed = RECORD_FIXED;
+#endif
+            size_t cap = maxPayload();
+            if (!base || cap < fixed)
+                return 0;
+
+            size_t tagLen = msg.tag ? std::strlen(msg.tag) : 0;
+            if (tagLen > 255)
+                tagLen = 255;
+            if (tagLen > cap - fixed)
+                tagLen = cap - fixed;
+            size_t msgLen = msg.message ? std::strlen(msg.message) : 0;
+            if (msgLen > cap - fixed - tagLen)
+                msgLen = cap - fixed - tagLen;
+
+            // Encode straight into the slot; no intermediate copy
+            uint8_t *record = beginRecord();
+            std::memcpy(record, &msg.timestamp, 8);
+            record[8] = static_cast<uint8_t>(msg.level);
+            record[9] = static_cast<uint8_t>(tagLen);
+#if LOGANYWHERE_ENABLE_ORIGIN
+            record[8] |= RECORD_HAS_ORIGIN;
+            std::memcpy(record + RECORD_FIXED, &msg.threadId, 4);
+            std::memcpy(record + RECORD_FIXED + 4, &msg.cpuId, 4);
+#endif
+            std::memcpy(record + fixed, msg.tag, tagLen);
+            std::memcpy(record + fixed + tagLen, msg.message, msgLen);
+            return commitRecord(fixed + tagLen + msgLen);
+        }
+
+        /**
+         * @brief Copies a record's payload out of the ring.
+         *
+         * @param id      Record ID in [firstId(), lastId()].
+         * @param out     Destination buffer.
+         * @param cap     Capacity of @p out.
+         * @param outLen  Set to the payload length on success.
+         * @return false if the ID is out of range, corrupt, or @p cap is too small.
+         */
+        bool read(uint64_t id, void *out, size_t cap, size_t &outLen) const
+        {
+            if (!base || id < first || id > last)
+                return false;
+            uint32_t index = static_cast<uint32_t>((id - 1) % slotCount);
+            uint64_t found = 0;
+            if (!slotValid(index, found) || found != id)
+                return false;
+            const PersistentSlotHeader *s = slotAt(index);
+            size_t length = s->frame.length - sizeof(s->id);
+            if (length > cap)
+                return false;
+            std::memcpy(out, payloadOf(s), length);
+            outLen = length;
+            return true;
+        }
+
+        /**
+         * @brief Decodes a payload produced by appendMessage().
+         *
+         * @param payload Bytes returned by read().
+         * @param len     Payload length.
+         * @param out     Receives views into @p payload.
+         * @return false if the payload is too short to be a log record.
+         */
+        static bool decodeMessage(const uint8_t *payload, size_t len, PersistentLogRecord &out)
+        {
+            if (len < RECORD_FIXED)
+                return false;
+            const bool hasOrigin = (payload[8] & RECORD_HAS_ORIGIN) != 0;
+            const size_t fixed = RECORD_FIXED + (hasOrigin ? RECORD_ORIGIN : 0);
+            if (len < fixed + payload[9])
+                return false;
+            std::memcpy(&out.timestamp, payload, 8);
+            out.level = static_cast<LogLevel>(payload[8] & ~RECORD_HAS_ORIGIN);
+            out.threadId = 0;
+            out.cpuId = UNKNOWN_CPU;
+            if (hasOrigin)
+            {
+                std::memcpy(&out.threadId, payload + RECORD_FIXED, 4);
+                std::memcpy(&out.cpuId, payload + RECORD_FIXED + 4, 4);
+            }
+            out.tagLen = payload[9];
+            out.tag = reinterpret_cast<const char *>(payload + fixed);
+            out.message = out.tag + out.tagLen;
+            out.messageLen = len - fixed - out.tagLen;
+            return true;
+        }
+
+        /**
+         * @brief Persists the highest ID a shipper has safely delivered.
+         * @param id Acknowledged record ID; older values are ignored.
+         */
+        void acknowledge(uint64_t id) noexcept
+        {
+            if (header && id > header->ackedId)
+                header->ackedId = id > last ? last : id;
+        }
+
+        /// @return Highest acknowledged ID (0 if none).
+        uint64_t acknowledgedId() const noexcept { return header ? header->ackedId : 0; }
+
+        /// @return First ID a shipper still needs to send.
+        uint64_t nextUnacknowledged() const noexcept
+        {
+            uint64_t next = acknowledgedId() + 1;
+            return next < first ? first : next;
+        }
+
+        /**
+         * @brief Flushes dirty pages to storage (power-loss durability).
+         * @return true on success.
+         */
+        bool sync()
+        {
+            return base && msync(base, mappedSize, MS_SYNC) == 0;
+        }
+
+        /**
+         * @brief LogHandler adapter: register with a PersistentRing* context.
+         */
+        static void logHandler(const LogMessage &msg, void *context)
+        {
+            static_cast<PersistentRing *>(context)->appendMessage(msg);
+        }
+
+    private:
+        static constexpr size_t RECORD_FIXED = 10;        ///< u64 ts + u8 level + u8 tagLen
+        static constexpr size_t RECORD_ORIGIN = 8;        ///< u32 thread ID + u32 CPU
+        static constexpr uint8_t RECORD_HAS_ORIGIN = 0x80; ///< Level-byte flag: origin follows tagLen
+        static constexpr size_t SLOT_OVERHEAD = sizeof(PersistentSlotHeader) + FRAME_TRAILER_SIZE;
+
+        int fd;
+        uint8_t *base;
+        size_t mappedSize;
+        PersistentRingHeader *header;
+        uint32_t slotCount;
+        uint32_t slotSize;
+        uint64_t first; ///< Oldest readable ID
+        uint64_t last;  ///< Newest ID (0 = empty)
+
+        PersistentSlotHeader *slotAt(uint32_t index) const
+        {
+            return reinterpret_cast<PersistentSlotHeader *>(
+                base + sizeof(PersistentRingHeader) + static_cast<size_t>(index) * slotSize);
+        }
+
+        static uint8_t *payloadOf(const PersistentSlotHeader *s)
+        {
+            return reinterpret_cast<uint8_t *>(const_cast<PersistentSlotHeader *>(s) + 1);
+        }
+
+        /**
+         * @brief Invalidates the next slot and returns its payload area.
+         *
+         * The frame magic is cleared first so a crash mid-copy never leaves
+         * an old, valid record behind in a half-overwritten slot.
+         */
+        uint8_t *beginRecord()
+        {
+            PersistentSlotHeader *s = slotAt(static_cast<uint32_t>(last % slotCount));
+            invalidateFrame(reinterpret_cast<uint8_t *>(s));
+            return payloadOf(s);
+        }
+
+        /**
+         * @brief Seals the slot opened by beginRecord() and advances the ring.
+         * @param len Payload bytes written.
+         * @return The new record's ID.
+         */
+        uint64_t commitRecord(size_t len)
+        {
+            uint64_t id = last + 1;
+            PersistentSlotHeader *s = slotAt(static_cast<uint32_t>(last % slotCount));
+            s->id = id;
+            sealFrame(reinterpret_cast<uint8_t *>(s), sizeof(s->id) + len);
+
+            last = id;
+            if (last - first + 1 > slotCount)
+                first = last - slotCount + 1;
+            return id;
+        }
+
+        /**
+         * @brief Checks that slot @p index holds an intact record that belongs there.
+         */
+        bool slotValid(uint32_t index, uint64_t &id) const
+        {
+            const PersistentSlotHeader *s = slotAt(index);
+            size_t length = 0;
+            if (!checkFrame(reinterpret_cast<const uint8_t *>(s), slotSize, slotSize - FRAME_OVERHEAD, length) ||
+                length < sizeof(s->id))
+                return false;
+            if (s->id == 0 || (s->id - 1) % slotCount != index)
+                return false;
+            id = s->id;
+            return true;
+        }
+
+        /**
+         * @brief Detects a header left behind by an interrupted initialization.
+         *
+         * The magic is written last, so a zero magic means initialization
+         * never finished; every other field must be zero or already hold
+         * the requested geometry, so a foreign file is never wiped.
+         */
+        bool unfinishedHeader(uint32_t slots, uint32_t bytesPerSlot) const
+        {
+            if (header->magic != 0 || header->ackedId != 0)
+                return false;
+            return (header->version == 0 || header->version == VERSION) &&
+                   (header->headerSize == 0 || header->headerSize == sizeof(PersistentRingHeader)) &&
+                   (header->slotCount == 0 || header->slotCount == slots) &&
+                   (header->slotSize == 0 || header->slotSize == bytesPerSlot);
+        }
+
+        /**
+         * @brief Locates the newest valid record and the oldest surviving one.
+         *
+         * Slot 0 anchors a binary search for the last slot continuing its
+         * ID sequence.  The answer is cross-checked against the following
+         * slot; only if that check fails (e.g. out-of-order page writeback
+         * after power loss) does recovery fall back to a linear scan.
+         */
+        void recover()
+        {
+            uint64_t id0 = 0, idN = 0, probe = 0;
+            uint32_t tail = 0;
+            last = 0;
+
+            if (slotValid(0, id0))
+            {
+                uint32_t lo = 0, hi = slotCount - 1;
+                while (lo < hi)
+                {
+                    uint32_t mid = lo + (hi - lo + 1) / 2;
+                    if (slotValid(mid, probe) && probe == id0 + mid)
+                        lo = mid;
+                    else
+                        hi = mid - 1;
+                }
+                tail = lo;
+                last = id0 + lo;
+            }
+            else if (slotCount > 1 && slotValid(slotCount - 1, idN))
+            {
+                tail = slotCount - 1;
+                last = idN;
+            }
+
+            if (!tailConsistent(tail))
+                scanForTail();
+
+            first = last >= slotCount ? last - slotCount + 1 : 1;
+            while (first <= last)
+            {
+                if (slotValid(static_cast<uint32_t>((first - 1) % slotCount), probe) && probe == first)
+                    break;
+                ++first; // oldest slot was the one being overwritten
+            }
+            if (header->ackedId > last)
+                header->ackedId = last;
+        }
+
+        /// @return true if the slot after @p tail does not hold a newer record.
+        bool tailConsistent(uint32_t tail) const
+        {
+            uint64_t next = 0;
+            if (last == 0)
+            {
+                // Empty unless some slot holds a record; check both ends only
+                return !slotValid(0, next) && (slotCount < 2 || !slotValid(slotCount - 1, next));
+            }
+            uint32_t after = (tail + 1) % slotCount;
+            if (after == 0 && tail == 0)
+                return true; // single-slot ring
+            return !slotValid(after, next) || next + slotCount - 1 == last;
+        }
+
+        /// @brief Bounded O(n) fallback: picks the highest valid ID in any slot.
+        void scanForTail()
+        {
+            uint64_t id = 0;
+            last = 0;
+            for (uint32_t i = 0; i < slotCount; ++i)
+            {
+                if (slotValid(i, id) && id > last)
+                    last = id;
+            }
+        }
+    };
+
+} // namespace LogAnywhere
+
+#endif // defined(__unix__) || defined(__APPLE__)
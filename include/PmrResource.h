@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file PmrResource.h
+ * @brief Adapts a std::pmr::memory_resource to LogAnywhere's MemoryResource.
+ *
+ * Kept out of MemoryResource.h so targets without <memory_resource> (most
+ * embedded toolchains) never see the include.
+ */
+
+#include <memory_resource>
+
+#include "MemoryResource.h"
+
+namespace LogAnywhere
+{
+
+    namespace detail
+    {
+        inline void *pmrAllocate(size_t bytes, size_t alignment, void *context)
+        {
+#if defined(__cpp_exceptions)
+            try
+            {
+                return static_cast<std::pmr::memory_resource *>(context)->allocate(bytes, alignment);
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+#else
+            return static_cast<std::pmr::memory_resource *>(context)->allocate(bytes, alignment);
+#endif
+        }
+
+        inline void pmrDeallocate(void *p, size_t bytes, size_t alignment, void *context)
+        {
+            static_cast<std::pmr::memory_resource *>(context)->deallocate(p, bytes, alignment);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Wraps @p upstream; allocation failures are reported as nullptr.
+     *
+     * @param upstream Resource that must outlive every user of the result.
+     * @return MemoryResource forwarding to @p upstream.
+     */
+    inline MemoryResource pmrResource(std::pmr::memory_resource *upstream)
+    {
+        return MemoryResource{detail::pmrAllocate, detail::pmrDeallocate, upstream};
+    }
+
+} // namespace LogAnywhere
@@ -0,0 +1,314 @@
+#pragma once
+
+/**
+ * @file RecordFrame.h
+ * @brief Checksummed, self-synchronizing record framing for persisted logs.
+ *
+ * Every record is written as one frame:
+ *
+ *     u32 magic | u32 length | u32 payload CRC32C | u32 header CRC32C
+ *     payload (length bytes)
+ *     u32 sync marker
+ *
+ * The header CRC lets a reader reject a garbage length before touching
+ * the payload, the payload CRC catches torn or bit-rotted data, and the
+ * trailing sync marker catches frames cut short by power loss.  A reader
+ * that meets a damaged region scans forward (at most a bounded number of
+ * bytes) for the next magic whose frame validates, so one torn write only
+ * costs the records it actually overlapped.
+ *
+ * All fields are little-endian.  Encoding and validation allocate nothing
+ * and are async-signal-safe.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+
+#include "ByteSink.h"
+#include "Checksum.h"
+
+/// Largest payload a frame may carry; longer length fields are treated as corruption.
+#ifndef LOGANYWHERE_FRAME_MAX_PAYLOAD
+#define LOGANYWHERE_FRAME_MAX_PAYLOAD 4096
+#endif
+
+/// Maximum bytes FrameReader scans past a damaged region before giving up.
+#ifndef LOGANYWHERE_FRAME_RESYNC_LIMIT
+#define LOGANYWHERE_FRAME_RESYNC_LIMIT 65536
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Fixed header at the start of every frame (16 bytes).
+     */
+    struct FrameHeader
+    {
+        uint32_t magic;      ///< FRAME_MAGIC once the frame is complete
+        uint32_t length;     ///< Payload bytes following the header
+        uint32_t payloadCrc; ///< CRC32C over the payload
+        uint32_t headerCrc;  ///< CRC32C over magic, length and payloadCrc
+    };
+
+    static_assert(sizeof(FrameHeader) == 16, "FrameHeader layout changed");
+
+    static constexpr uint32_t FRAME_MAGIC = 0x4D52464Cu;  ///< "LFRM" little-endian
+    static constexpr uint32_t FRAME_SYNC = 0x5AA5C3E7u;   ///< Trailer after each payload
+    static constexpr size_t FRAME_HEADER_SIZE = sizeof(FrameHeader);
+    static constexpr size_t FRAME_TRAILER_SIZE = sizeof(uint32_t);
+    static constexpr size_t FRAME_OVERHEAD = FRAME_HEADER_SIZE + FRAME_TRAILER_SIZE;
+
+    /// @return Total encoded size of a frame carrying @p payloadLen bytes.
+    constexpr size_t frameSize(size_t payloadLen)
+    {
+        return FRAME_OVERHEAD + payloadLen;
+    }
+
+    namespace detail
+    {
+        inline uint32_t frameHeaderCrc(const FrameHeader &h)
+        {
+            return crc32c(0, &h, offsetof(FrameHeader, headerCrc));
+        }
+    } // namespace detail
+
+    /**
+     * @brief Marks a frame as incomplete before it is (re)written in place.
+     *
+     * Clearing the magic first means a crash part-way through a rewrite
+     * never leaves a stale frame that still validates.
+     *
+     * @param frame Start of the frame.
+     */
+    inline void invalidateFrame(uint8_t *frame)
+    {
+        uint32_t zero = 0;
+        std::memcpy(frame, &zero, sizeof(zero));
+        std::atomic_signal_fence(std::memory_order_release);
+    }
+
+    /**
+     * @brief Seals a frame whose payload was already written at frame + FRAME_HEADER_SIZE.
+     *
+     * Writes the checksums and sync marker, then publishes the magic last.
+     *
+     * @param frame       Start of the frame (room for frameSize(payloadLen) bytes).
+     * @param payloadLen  Payload length.
+     */
+    inline void sealFrame(uint8_t *frame, size_t payloadLen)
+    {
+        FrameHeader h;
+        h.magic = FRAME_MAGIC;
+        h.length = static_cast<uint32_t>(payloadLen);
+        h.payloadCrc = crc32c(0, frame + FRAME_HEADER_SIZE, payloadLen);
+        h.headerCrc = detail::frameHeaderCrc(h);
+
+        std::memcpy(frame + FRAME_HEADER_SIZE + payloadLen, &FRAME_SYNC, FRAME_TRAILER_SIZE);
+        std::memcpy(frame + sizeof(uint32_t), reinterpret_cast<const uint8_t *>(&h) + sizeof(uint32_t),
+                    FRAME_HEADER_SIZE - sizeof(uint32_t));
+        std::atomic_signal_fence(std::memory_order_release);
+        std::memcpy(frame, &h.magic, sizeof(h.magic));
+    }
+
+    /**
+     * @brief Encodes one frame into a caller buffer.
+     *
+     * @param payload Payload bytes.
+     * @param len     Payload length.
+     * @param out     Destination buffer.
+     * @param cap     Capacity of @p out.
+     * @return Encoded size, or 0 if @p cap is smaller than frameSize(len).
+     */
+    inline size_t encodeFrame(const void *payload, size_t len, uint8_t *out, size_t cap)
+    {
+        if (cap < frameSize(len) || len > UINT32_MAX)
+            return 0;
+        invalidateFrame(out);
+        std::memcpy(out + FRAME_HEADER_SIZE, payload, len);
+        sealFrame(out, len);
+        return frameSize(len);
+    }
+
+    /**
+     * @brief Validates the frame starting at @p data.
+     *
+     * @param data        Candidate frame start.
+     * @param avail       Bytes available from @p data.
+     * @param maxPayload  Largest acceptable length field.
+     * @param payloadLen  Set to the payload length on success.
+     * @return true if magic, header CRC, payload CRC and sync marker all check out.
+     */
+    inline bool checkFrame(const uint8_t *data, size_t avail, size_t maxPayload, size_t &payloadLen)
+    {
+        if (avail < FRAME_OVERHEAD)
+            return false;
+        FrameHeader h;
+        std::memcpy(&h, data, sizeof(h));
+        if (h.magic != FRAME_MAGIC || h.length > maxPayload || h.length > avail - FRAME_OVERHEAD)
+            return false;
+        if (detail::frameHeaderCrc(h) != h.headerCrc)
+            return false;
+        uint32_t sync;
+        std::memcpy(&sync, data + FRAME_HEADER_SIZE + h.length, sizeof(sync));
+        if (sync != FRAME_SYNC || crc32c(0, data + FRAME_HEADER_SIZE, h.length) != h.payloadCrc)
+            return false;
+        payloadLen = h.length;
+        return true;
+    }
+
+    /**
+     * @brief ByteSink stage that wraps every write in one frame.
+     *
+     * Each write() reaches the downstream sink as a single call, so an
+     * fd-backed sink issues exactly one write() per record.  Chain it after
+     * an LzCompressor to frame compressed blocks.
+     */
+    class FrameEncoder
+    {
+    public:
+        /**
+         * @param sink     Downstream sink receiving encoded frames.
+         * @param context  User data passed to @p sink.
+         */
+        FrameEncoder(ByteSink sink, void *context)
+            : sink(sink), sinkContext(context), frames(0), rejected(0)
+        {
+        }
+
+        /**
+         * @brief Frames and emits one record.
+         * @return false (and nothing is emitted) if @p len exceeds LOGANYWHERE_FRAME_MAX_PAYLOAD.
+         */
+        bool write(const void *payload, size_t len)
+        {
+            size_t n = encodeFrame(payload, len, buffer, sizeof(buffer));
+            if (n == 0)
+            {
+                ++rejected;
+                return false;
+            }
+            if (sink)
+                sink(buffer, n, sinkContext);
+            ++frames;
+            return true;
+        }
+
+        /// @return Number of frames emitted.
+        uint64_t framesWritten() const noexcept { return frames; }
+
+        /// @return Number of writes refused for being too large.
+        uint64_t framesRejected() const noexcept { return rejected; }
+
+        /**
+         * @brief ByteSink adapter: pass a FrameEncoder* as the context.
+         */
+        static void sinkAdapter(const uint8_t *data, size_t len, void *context)
+        {
+            static_cast<FrameEncoder *>(context)->write(data, len);
+        }
+
+    private:
+        ByteSink sink;
+        void *sinkContext;
+        uint64_t frames;
+        uint64_t rejected;
+        uint8_t buffer[frameSize(LOGANYWHERE_FRAME_MAX_PAYLOAD)];
+    };
+
+    /**
+     * @brief Iterates the valid frames in a byte range (file contents, mmap).
+     *
+     * Damaged or partially written regions are skipped: the reader scans
+     * forward for the next frame that validates, looking at most
+     * @c resyncLimit bytes past the damage.  If that window holds no valid
+     * frame the reader stops and scanLimitHit() reports it, so a wiped
+     * region can never turn a read into an unbounded search.
+     */
+    class FrameReader
+    {
+    public:
+        /**
+         * @param data         Start of the encoded bytes.
+         * @param len          Number of bytes.
+         * @param resyncLimit  Maximum bytes scanned per damaged region.
+         * @param maxPayload   Largest length field accepted as genuine.
+         */
+        FrameReader(const uint8_t *data, size_t len,
+                    size_t resyncLimit = LOGANYWHERE_FRAME_RESYNC_LIMIT,
+                    size_t maxPayload = LOGANYWHERE_FRAME_MAX_PAYLOAD)
+            : data(data), len(len), pos(0), resyncLimit(resyncLimit), maxPayload(maxPayload),
+              skipped(0), resyncs(0), limitHit(false)
+        {
+        }
+
+        /**
+         * @brief Advances to the next valid frame.
+         *
+         * @param payload  Set to the payload (points into the input range).
+         * @param outLen   Set to the payload length.
+         * @return false at the end of the data or when the resync limit is hit.
+         */
+        bool next(const uint8_t *&payload, size_t &outLen)
+        {
+            if (limitHit || pos >= len)
+                return false;
+
+            size_t n = 0;
+            if (checkFrame(data + pos, len - pos, maxPayload, n))
+                return take(payload, outLen, n);
+
+            // Damaged region: bounded forward scan for the next valid frame
+            size_t start = pos;
+            size_t stop = (len - pos > resyncLimit) ? pos + resyncLimit : len;
+            for (size_t p = pos + 1; p < stop; ++p)
+            {
+                if (data[p] != static_cast<uint8_t>(FRAME_MAGIC) ||
+                    !checkFrame(data + p, len - p, maxPayload, n))
+                    continue;
+                skipped += p - start;
+                ++resyncs;
+                pos = p;
+                return take(payload, outLen, n);
+            }
+            skipped += stop - start;
+            pos = stop;
+            if (stop < len)
+                limitHit = true;
+            return false;
+        }
+
+        /// @return Offset of the next byte to examine.
+        size_t offset() const noexcept { return pos; }
+
+        /// @return Bytes discarded as damaged or incomplete so far.
+        size_t skippedBytes() const noexcept { return skipped; }
+
+        /// @return Number of times the reader resynchronized after damage.
+        size_t resyncCount() const noexcept { return resyncs; }
+
+        /// @return true if reading stopped because a damaged region exceeded the scan limit.
+        bool scanLimitHit() const noexcept { return limitHit; }
+
+    private:
+        const uint8_t *data;
+        size_t len;
+        size_t pos;
+        size_t resyncLimit;
+        size_t maxPayload;
+        size_t skipped;
+        size_t resyncs;
+        bool limitHit;
+
+        bool take(const uint8_t *&payload, size_t &outLen, size_t n)
+        {
+            payload = data + pos + FRAME_HEADER_SIZE;
+            outLen = n;
+            pos += frameSize(n);
+            return true;
+        }
+    };
+
+} // namespace LogAnywhere
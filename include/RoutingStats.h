@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file RoutingStats.h
+ * @brief Optional routing counters: what was logged, delivered and dropped.
+ *
+ * Enabled with LOGANYWHERE_ENABLE_STATS=1.  Hot-path counters live in
+ * cache-line-sized shards; each thread is pinned to one shard on first use,
+ * so concurrent loggers increment different cache lines and never contend.
+ * HandlerManager::snapshotStats() sums the shards on read.
+ *
+ * Totals are sharded inside the HandlerManager.  Per-handler and per-tag
+ * counts are sharded the same way but stored on the HandlerEntry and the
+ * Tag, so they exist for every handler (growable registries included),
+ * follow an entry when it moves, and cost LOGANYWHERE_STATS_SHARDS cache
+ * lines per handler and per tag.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "LogLevel.h"
+
+/// Set to 1 to count routing decisions (see HandlerManager::snapshotStats()).
+#ifndef LOGANYWHERE_ENABLE_STATS
+#define LOGANYWHERE_ENABLE_STATS 0
+#endif
+
+/// Number of per-thread counter shards; threads beyond this share shards.
+#ifndef LOGANYWHERE_STATS_SHARDS
+#define LOGANYWHERE_STATS_SHARDS 8
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Relaxed atomic counter that can be copied (for copyable owners).
+     */
+    struct StatCounter
+    {
+        std::atomic<uint64_t> value{0};
+
+        StatCounter() = default;
+        StatCounter(const StatCounter &o) : value(o.load()) {}
+        StatCounter &operator=(const StatCounter &o)
+        {
+            value.store(o.load(), std::memory_order_relaxed);
+            return *this;
+        }
+
+        void add(uint64_t n = 1) noexcept { value.fetch_add(n, std::memory_order_relaxed); }
+        uint64_t load() const noexcept { return value.load(std::memory_order_relaxed); }
+        void reset() noexcept { value.store(0, std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Counters for one handler, as returned by a snapshot.
+     */
+    struct HandlerStats
+    {
+        uint16_t id;                   ///< Handler ID
+        const char *name;              ///< Handler name (may be null)
+        uint64_t delivered;            ///< Messages passed to the callback
+        uint64_t droppedByLevel;       ///< Messages below the handler's threshold
+        uint64_t droppedByDisabled;    ///< Messages skipped while disabled
+        uint32_t droppedSubscriptions; ///< Tags it could not join (tag full)
+    };
+
+    /**
+     * @brief Returns the calling thread's shard index (assigned round-robin on first use).
+     */
+    inline size_t statsShardIndex()
+    {
+        static std::atomic<size_t> nextShard{0};
+        thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % LOGANYWHERE_STATS_SHARDS;
+        return shard;
+    }
+
+    /**
+     * @brief One shard of a handler's counters, on its own cache line.
+     */
+    struct alignas(64) HandlerCounterShard
+    {
+        StatCounter delivered;         ///< Messages passed to the callback
+        StatCounter droppedByLevel;    ///< Messages below the handler's threshold
+        StatCounter droppedByDisabled; ///< Messages skipped while disabled
+    };
+
+    /**
+     * @brief Per-thread-sharded counters of one handler (stored on HandlerEntry).
+     */
+    struct HandlerCounters
+    {
+        HandlerCounterShard shards[LOGANYWHERE_STATS_SHARDS];
+
+        /// Sums every shard into the counter fields of @p out.
+        void sum(HandlerStats &out) const noexcept
+        {
+            out.delivered = out.droppedByLevel = out.droppedByDisabled = 0;
+            for (const HandlerCounterShard &s : shards)
+            {
+                out.delivered += s.delivered.load();
+                out.droppedByLevel += s.droppedByLevel.load();
+                out.droppedByDisabled += s.droppedByDisabled.load();
+            }
+        }
+
+        /// Zeroes every shard.
+        void reset() noexcept
+        {
+            for (HandlerCounterShard &s : shards)
+            {
+                s.delivered.reset();
+                s.droppedByLevel.reset();
+                s.droppedByDisabled.reset();
+            }
+        }
+    };
+
+    /**
+     * @brief One shard of a tag's per-level counts, on its own cache line.
+     */
+    struct alignas(64) TagCounterShard
+    {
+        StatCounter logged[LOG_LEVEL_COUNT];
+    };
+
+    /**
+     * @brief Per-thread-sharded message counts of one tag (stored on Tag).
+     */
+    struct TagCounters
+    {
+        TagCounterShard shards[LOGANYWHERE_STATS_SHARDS];
+
+        /// Counts one message at @p level from shard @p shard.
+        void add(size_t shard, LogLevel level) noexcept { shards[shard].logged[static_cast<size_t>(level)].add(); }
+
+        /// @return Messages logged at @p level, summed over shards.
+        uint64_t sum(size_t level) const noexcept
+        {
+            uint64_t n = 0;
+            for (const TagCounterShard &s : shards)
+                n += s.logged[level].load();
+            return n;
+        }
+    };
+
+    /**
+     * @brief Aggregated routing counters for one HandlerManager.
+     *
+     * Totals include handlers that have since been deleted; the per-handler
+     * array covers the first MaxHandlers handlers registered at snapshot
+     * time (see HandlerManager::snapshotHandlerStats() for the rest).
+     */
+    template <size_t MaxHandlers>
+    struct RoutingStatsSnapshotT
+    {
+        uint64_t logged[LOG_LEVEL_COUNT]; ///< Messages logged, by level
+        uint64_t delivered;               ///< Handler invocations
+        uint64_t droppedByLevel;          ///< Skipped: below a handler's level
+        uint64_t droppedByDisabled;       ///< Skipped: handler disabled
+        uint64_t droppedSubscriptions;    ///< Subscriptions refused because a tag was full
+        HandlerStats handlers[MaxHandlers];
+        size_t handlerCount;              ///< Rows filled in handlers[]
+    };
+
+    /**
+     * @brief Per-level message counts for one tag.
+     */
+    struct TagStatsSnapshot
+    {
+        uint64_t logged[LOG_LEVEL_COUNT]; ///< Messages logged, by level
+        uint64_t total;                   ///< Sum over all levels
+    };
+
+    /**
+     * @brief One thread's share of the manager totals, padded to whole cache lines.
+     */
+    struct alignas(64) RoutingStatsShard
+    {
+        std::atomic<uint64_t> logged[LOG_LEVEL_COUNT];
+        std::atomic<uint64_t> delivered;
+        std::atomic<uint64_t> droppedByLevel;
+        std::atomic<uint64_t> droppedByDisabled;
+    };
+
+    /**
+     * @brief Sharded totals owned by a HandlerManager.
+     *
+     * The per-handler share of each event is counted on the entry itself,
+     * in the same shard.
+     */
+    class RoutingStats
+    {
+    public:
+        using Shard = RoutingStatsShard;
+
+        RoutingStats() { reset(); }
+
+        RoutingStats(const RoutingStats &) = delete;
+        RoutingStats &operator=(const RoutingStats &) = delete;
+
+        /// @return Shard @p index (see statsShardIndex()).
+        Shard &shard(size_t index) noexcept { return shards[index]; }
+
+        /// @return The calling thread's shard.
+        Shard &local() noexcept { return shards[statsShardIndex()]; }
+
+        /// Counts a message entering dispatch.
+        void countLogged(LogLevel level) noexcept
+        {
+            local().logged[static_cast<size_t>(level)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Counts a delivery to a handler in shard @p index.
+        static void countDelivered(Shard &s, HandlerCounters &h, size_t index) noexcept
+        {
+            s.delivered.fetch_add(1, std::memory_order_relaxed);
+            h.shards[index].delivered.add();
+        }
+
+        /// Counts a message skipped by a handler's level gate.
+        static void countDroppedByLevel(Shard &s, HandlerCounters &h, size_t index) noexcept
+        {
+            s.droppedByLevel.fetch_add(1, std::memory_order_relaxed);
+            h.shards[index].droppedByLevel.add();
+        }
+
+        /// Counts a message skipped because a handler is disabled.
+        static void countDroppedByDisabled(Shard &s, HandlerCounters &h, size_t index) noexcept
+        {
+            s.droppedByDisabled.fetch_add(1, std::memory_order_relaxed);
+            h.shards[index].droppedByDisabled.add();
+        }
+
+        /// Counts subscriptions refused at registration.
+        void countDroppedSubscriptions(uint64_t n) noexcept
+        {
+            droppedSubscriptions.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        /// Sums the totals (not per-handler data) into @p out.
+        template <typename Snapshot>
+        void sumTotals(Snapshot &out) const noexcept
+        {
+            for (auto &v : out.logged)
+                v = 0;
+            out.delivered = out.droppedByLevel = out.droppedByDisabled = 0;
+            for (const Shard &s : shards)
+            {
+                for (size_t l = 0; l < LOG_LEVEL_COUNT; ++l)
+                    out.logged[l] += s.logged[l].load(std::memory_order_relaxed);
+                out.delivered += s.delivered.load(std::memory_order_relaxed);
+                out.droppedByLevel += s.droppedByLevel.load(std::memory_order_relaxed);
+                out.droppedByDisabled += s.droppedByDisabled.load(std::memory_order_relaxed);
+            }
+            out.droppedSubscriptions = droppedSubscriptions.load(std::memory_order_relaxed);
+        }
+
+        /// Zeroes every counter.
+        void reset() noexcept
+        {
+            for (Shard &s : shards)
+            {
+                for (auto &v : s.logged)
+                    v.store(0, std::memory_order_relaxed);
+                s.delivered.store(0, std::memory_order_relaxed);
+                s.droppedByLevel.store(0, std::memory_order_relaxed);
+                s.droppedByDisabled.store(0, std::memory_order_relaxed);
+            }
+            droppedSubscriptions.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        Shard shards[LOGANYWHERE_STATS_SHARDS];
+        std::atomic<uint64_t> droppedSubscriptions;
+    };
+
+} // namespace LogAnywhere
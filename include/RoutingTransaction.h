@@ -0,0 +1,335 @@
+#pragma once
+
+/**
+ * @file RoutingTransaction.h
+ * @brief Stages many routing changes and applies them to a HandlerManager at once.
+ *
+ * Applying a new routing configuration one call at a time rescans Tags and
+ * shifts handlers[] for every deletion, and leaves the registry half
+ * updated if a later call fails.  A RoutingTransaction records
+ * registrations, deletions and level changes in a fixed array, checks all
+ * of them against the manager, and then applies them in one pass:
+ *
+ *  - every deleted handler is marked first, so each affected Tag is swept
+ *    once and handlers[] is compacted once (each survivor moves at most
+ *    once), instead of once per deletion;
+ *  - registrations append to Tag lists as usual;
+ *  - level changes are plain stores.
+ *
+ * commit() either applies every staged change or none.  Like the other
+ * registration calls it must not run concurrently with logging: Tags own
+ * their subscriber arrays and dispatch reads them in place.
+ *
+ * @code
+ * RoutingTransaction tx(mgr);
+ * tx.deleteHandler("old-mqtt");
+ * tx.registerHandler(LogLevel::WARN, mqttOut, &mqtt, netTags, 3, "mqtt");
+ * tx.setLevel("serial", LogLevel::DEBUG);
+ * if (!tx.commit()) { ... nothing changed ... }
+ * @endcode
+ */
+
+#include "HandlerManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// Changes one RoutingTransaction can stage before commit().
+#ifndef LOGANYWHERE_MAX_STAGED_CHANGES
+#define LOGANYWHERE_MAX_STAGED_CHANGES 16
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Builder that stages routing changes and commits them together.
+     */
+    class RoutingTransaction
+    {
+    public:
+        static constexpr size_t MAX_CHANGES = LOGANYWHERE_MAX_STAGED_CHANGES; ///< Staging capacity
+
+        /**
+         * @brief Starts an empty transaction against @p manager.
+         *
+         * @param manager Registry the changes will be applied to.
+         */
+        explicit RoutingTransaction(HandlerManager &manager)
+            : mgr(manager), changeCount(0)
+        {
+        }
+
+        /**
+         * @brief Stages a registration (see HandlerManager::registerHandlerForTags()).
+         *
+         * @param level     Minimum log level to invoke this handler.
+         * @param fn        Callback function pointer.
+         * @param ctx       User-supplied context passed to the callback.
+         * @param tagList   Tags to subscribe to; must stay valid until commit().
+         * @param tagCount  Number of elements in @p tagList.
+         * @param name      Optional handler name.
+         * @return false if the staging array is full.
+         */
+        bool registerHandler(LogLevel level,
+                             LogHandler fn,
+                             void *ctx,
+                             const Tag *tagList[],
+                             size_t tagCount,
+                             const char *name = nullptr)
+        {
+            Change *c = stage(Change::Register);
+            if (!c)
+                return false;
+            c->level = level;
+            c->fn = fn;
+            c->ctx = ctx;
+            c->tags = tagList;
+            c->tagCount = tagCount;
+            c->name = name;
+            return true;
+        }
+
+        /**
+         * @brief Stages the deletion of an existing handler by ID.
+         * @param id Handler ID.
+         * @return false if the staging array is full.
+         */
+        bool deleteHandler(uint16_t id)
+        {
+            Change *c = stage(Change::Delete);
+            if (!c)
+                return false;
+            c->id = id;
+            return true;
+        }
+
+        /**
+         * @brief Stages the deletion of an existing handler by name.
+         * @param name Handler name.
+         * @return false if the staging array is full.
+         */
+        bool deleteHandler(const char *name)
+        {
+            Change *c = stage(Change::Delete);
+            if (!c)
+                return false;
+            c->name = name;
+            return true;
+        }
+
+        /**
+         * @brief Stages a new minimum level for a handler by ID.
+         * @param id    Handler ID (of a handler that exists before commit()).
+         * @param level New threshold.
+         * @return false if the staging array is full.
+         */
+        bool setLevel(uint16_t id, LogLevel level)
+        {
+            Change *c = stage(Change::SetLevel);
+            if (!c)
+                return false;
+            c->id = id;
+            c->level = level;
+            return true;
+        }
+
+        /**
+         * @brief Stages a new minimum level for a handler by name.
+         *
+         * The name may also be that of a handler registered in this
+         * transaction; level changes are applied after registrations.
+         *
+         * @param name  Handler name.
+         * @param level New threshold.
+         * @return false if the staging array is full.
+         */
+        bool setLevel(const char *name, LogLevel level)
+        {
+            Change *c = stage(Change::SetLevel);
+            if (!c)
+                return false;
+            c->name = name;
+            c->level = level;
+            return true;
+        }
+
+        /// @return Number of staged changes.
+        size_t size() const noexcept { return changeCount; }
+
+        /// Drops every staged change without applying it.
+        void discard() noexcept { changeCount = 0; }
+
+        /**
+         * @brief Validates and applies every staged change.
+         *
+         * Fails without touching the manager if a deletion or level change
+         * names no handler, or if the registrations would not fit.  Static
+         * managers apply deletions before registrations, so freed slots can
+         * be reused; growable managers register first and roll those back
+         * if memory runs out, before anything else changed.
+         *
+         * @return true if everything was applied; the transaction is then empty.
+         */
+        bool commit();
+
+    private:
+        /// One staged operation.
+        struct Change
+        {
+            enum Kind : uint8_t
+            {
+                Register,
+                Delete,
+                SetLevel
+            } kind;
+            LogLevel level;
+            uint16_t id;
+            const char *name;
+            LogHandler fn;
+            void *ctx;
+            const Tag **tags;
+            size_t tagCount;
+        };
+
+        HandlerManager &mgr;          ///< Target registry
+        Change changes[MAX_CHANGES];  ///< Staged operations in call order
+        size_t changeCount;           ///< Valid entries in changes[]
+
+        /// @return A fresh change of @p kind, or nullptr if staging is full.
+        Change *stage(Change::Kind kind)
+        {
+            if (changeCount == MAX_CHANGES)
+                return nullptr;
+            Change &c = changes[changeCount++];
+            c = Change{};
+            c.kind = kind;
+            return &c;
+        }
+
+        /// @return The live handler a Delete/SetLevel change refers to, or nullptr.
+        HandlerEntry *target(const Change &c) const
+        {
+            return c.name ? mgr.findEntryByName(c.name) : mgr.findEntryByID(c.id);
+        }
+
+        /// @return true if a Register change in this transaction uses @p name.
+        bool stagesName(const char *name) const
+        {
+            for (size_t i = 0; i < changeCount; ++i)
+            {
+                const Change &c = changes[i];
+                if (c.kind == Change::Register && c.name && std::strcmp(c.name, name) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        /// Registers every staged handler; undoes them all if one fails.
+        bool applyRegistrations();
+    };
+
+    /**
+     * @brief Checks every staged change, then applies them in one pass.
+     *
+     * @return true if all changes were applied, false if none were.
+     */
+    inline bool RoutingTransaction::commit()
+    {
+        HandlerEntry *doomed[MAX_CHANGES];
+        size_t doomedCount = 0;
+        size_t registrations = 0;
+
+        // 1) Resolve and validate without changing anything
+        for (size_t i = 0; i < changeCount; ++i)
+        {
+            const Change &c = changes[i];
+            if (c.kind == Change::Register)
+            {
+                ++registrations;
+                continue;
+            }
+            if (c.kind != Change::Delete)
+                continue;
+            HandlerEntry *e = target(c);
+            if (!e)
+                return false;
+            bool seen = false;
+            for (size_t d = 0; d < doomedCount; ++d)
+                seen = seen || doomed[d] == e;
+            if (!seen)
+                doomed[doomedCount++] = e;
+        }
+        // Level changes need a handler that survives the commit
+        for (size_t i = 0; i < changeCount; ++i)
+        {
+            const Change &c = changes[i];
+            if (c.kind != Change::SetLevel || (c.name && stagesName(c.name)))
+                continue;
+            HandlerEntry *e = target(c);
+            bool deleted = false;
+            for (size_t d = 0; d < doomedCount; ++d)
+                deleted = deleted || doomed[d] == e;
+            if (!e || deleted)
+                return false;
+        }
+        const size_t limit = mgr.isGrowable() ? UINT16_MAX : HandlerManager::MAX_HANDLERS;
+        if (mgr.handlerCount - doomedCount + registrations > limit)
+            return false;
+
+        // 2) Apply
+        if (mgr.isGrowable())
+        {
+            // Entries never move here, so doomed[] stays valid across registration
+            if (!applyRegistrations())
+                return false;
+            mgr.removeEntries(doomed, doomedCount);
+        }
+        else
+        {
+            mgr.removeEntries(doomed, doomedCount);
+            applyRegistrations();
+        }
+        for (size_t i = 0; i < changeCount; ++i)
+        {
+            const Change &c = changes[i];
+            if (c.kind == Change::SetLevel)
+            {
+                target(c)->level = c.level;
+                detail::refreshSubscriber(target(c));
+            }
+        }
+        changeCount = 0;
+        return true;
+    }
+
+    /**
+     * @brief Creates and subscribes every staged registration in order.
+     *
+     * Only a growable manager can fail here (out of memory); every entry
+     * this call created is then removed again.
+     *
+     * @return false if a registration failed and was rolled back.
+     */
+    inline bool RoutingTransaction::applyRegistrations()
+    {
+        HandlerEntry *created[MAX_CHANGES];
+        size_t createdCount = 0;
+        for (size_t i = 0; i < changeCount; ++i)
+        {
+            const Change &c = changes[i];
+            if (c.kind != Change::Register)
+                continue;
+            HandlerEntry *e = mgr.createEntry(c.level, c.fn, c.ctx, c.tags, c.tagCount, c.name);
+            if (e)
+                created[createdCount++] = e;
+            if (!e || !mgr.subscribeEntryToTags(e, c.tags, c.tagCount))
+            {
+                mgr.removeEntries(created, createdCount);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace LogAnywhere
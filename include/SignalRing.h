@@ -0,0 +1,200 @@
+#pragma once
+
+/**
+ * @file SignalRing.h
+ * @brief Async-signal-safe log ring for signal handlers and ISRs.
+ *
+ * Logger::log() runs every subscribed handler synchronously, which is not
+ * allowed inside a POSIX signal handler or an interrupt service routine.
+ * SignalRing splits logging in two:
+ *
+ *  - log() is the signal-side half.  It reserves a position with one
+ *    fetch_add, claims the slot with one compare-and-swap and copies the
+ *    tag pointer and message text into it.  No formatting, no locks, no
+ *    handler calls and no loops that depend on other threads, so it is
+ *    wait-free and may interrupt any code, including another log() or a
+ *    drain() in progress.
+ *  - drain() runs in normal context and passes every committed record to
+ *    Logger::log(), in reservation order.
+ *
+ * If the slot for a reservation still holds an undrained record the new
+ * record is dropped and counted; the slot keeps a skip count so drain()
+ * steps over the abandoned position instead of waiting for it.
+ *
+ * Records keep the message text (truncated to LOGANYWHERE_SIGNAL_TEXT - 1
+ * bytes) and the Tag pointer, so tags must be static as usual.  A zero
+ * timestamp is stamped by the Logger when the record is drained; pass an
+ * explicit one (e.g. from clock_gettime(), which is async-signal-safe) to
+ * keep the time of the signal itself.
+ *
+ * @code
+ * static SignalRing signalLog;
+ * void onSigusr1(int) { signalLog.log(LogLevel::WARN, &SIGNALS, "SIGUSR1"); }
+ * // main loop:
+ * signalLog.drain(logger);
+ * @endcode
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "LogLevel.h"
+#include "Tag.h"
+#include "Logger.h"
+
+/// Slots in a SignalRing (power of two).
+#ifndef LOGANYWHERE_SIGNAL_SLOTS
+#define LOGANYWHERE_SIGNAL_SLOTS 32
+#endif
+
+/// Bytes of message text per slot, including the terminator.
+#ifndef LOGANYWHERE_SIGNAL_TEXT
+#define LOGANYWHERE_SIGNAL_TEXT 96
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Wait-free multi-producer ring drained into a Logger.
+     */
+    class SignalRing
+    {
+    public:
+        static constexpr size_t SLOTS = LOGANYWHERE_SIGNAL_SLOTS; ///< Slot count
+        static constexpr size_t TEXT = LOGANYWHERE_SIGNAL_TEXT;   ///< Text bytes per slot
+        static_assert(SLOTS > 1 && (SLOTS & (SLOTS - 1)) == 0, "signal ring slots must be a power of two");
+        static_assert(SLOTS <= (1u << 29), "signal ring positions are kept in 30 bits");
+        static_assert(TEXT >= 2 && TEXT <= 65536, "signal ring text must hold a character and a terminator");
+        static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                      "SignalRing needs lock-free 32-bit atomics to be async-signal-safe");
+
+        SignalRing()
+        {
+            for (size_t i = 0; i < SLOTS; ++i)
+            {
+                slots[i].state.store(stamp(static_cast<uint32_t>(i), FREE), std::memory_order_relaxed);
+                slots[i].skips.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        SignalRing(const SignalRing &) = delete;
+        SignalRing &operator=(const SignalRing &) = delete;
+
+        /**
+         * @brief Queues a preformatted message.  Async-signal-safe and wait-free.
+         *
+         * @param level     Severity level.
+         * @param tag       Tag to dispatch against when drained (must be static).
+         * @param message   Text to copy; truncated to fit the slot.
+         * @param timestamp Optional timestamp (0 ⇒ stamped when drained).
+         * @return false if the record was dropped (ring full or null tag).
+         */
+        bool log(LogLevel level,
+                 const Tag *tag,
+                 const char *message,
+                 uint64_t timestamp = 0) noexcept
+        {
+            if (!tag)
+                return false;
+            const uint32_t pos = tail.fetch_add(1, std::memory_order_relaxed);
+            Slot &s = slots[pos & (SLOTS - 1)];
+            uint32_t expected = stamp(pos, FREE);
+            if (!s.state.compare_exchange_strong(expected, stamp(pos, WRITING),
+                                                 std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                // An older record still owns the slot: give the position up
+                s.skips.fetch_add(1, std::memory_order_release);
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            s.timestamp = timestamp;
+            s.level = level;
+            s.tag = tag;
+            size_t n = 0;
+            if (message)
+                while (n < TEXT - 1 && message[n] != '\0')
+                    ++n;
+            std::memcpy(s.text, message ? message : "", n);
+            s.text[n] = '\0';
+            s.state.store(stamp(pos, COMMITTED), std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Dispatches queued records through @p logger.  Normal context only.
+         *
+         * Single consumer.  Stops at the first position whose record is
+         * still being written; the next call picks it up.
+         *
+         * @param logger     Logger that runs the handlers.
+         * @param maxRecords Stop after this many records.
+         * @return Number of records dispatched.
+         */
+        size_t drain(const Logger &logger, size_t maxRecords = SIZE_MAX)
+        {
+            size_t delivered = 0;
+            while (delivered < maxRecords)
+            {
+                Slot &s = slots[head & (SLOTS - 1)];
+                const uint32_t state = s.state.load(std::memory_order_acquire);
+                if (state == stamp(head, COMMITTED))
+                {
+                    logger.log(s.level, s.tag, s.text, s.timestamp);
+                    s.state.store(stamp(head + SLOTS, FREE), std::memory_order_release);
+                    ++head;
+                    ++delivered;
+                    continue;
+                }
+                if (state != stamp(head, FREE) || s.skips.load(std::memory_order_acquire) == 0)
+                    break;
+                // Unclaimed and a reservation gave up on this slot: take the
+                // position so its (possibly late) producer cannot claim it
+                uint32_t expected = state;
+                if (s.state.compare_exchange_strong(expected, stamp(head + SLOTS, FREE),
+                                                    std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    s.skips.fetch_sub(1, std::memory_order_relaxed);
+                    ++head;
+                }
+            }
+            return delivered;
+        }
+
+        /// @return Records dropped because their slot was still in use.
+        uint32_t dropped() const noexcept { return droppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        /// Slot state, kept in the low two bits of Slot::state.
+        enum : uint32_t
+        {
+            FREE = 0,      ///< Waiting for the producer of this position
+            WRITING = 1,   ///< Claimed, text being copied
+            COMMITTED = 2  ///< Ready for drain()
+        };
+
+        struct Slot
+        {
+            std::atomic<uint32_t> state; ///< (position << 2) | FREE/WRITING/COMMITTED
+            std::atomic<uint32_t> skips; ///< Reservations that found the slot busy
+            uint64_t timestamp;
+            const Tag *tag;
+            LogLevel level;
+            char text[TEXT];
+        };
+
+        std::atomic<uint32_t> tail{0};          ///< Next position to reserve
+        std::atomic<uint32_t> droppedCount{0};  ///< Records given up
+        uint32_t head = 0;                      ///< Next position to drain (consumer only)
+        Slot slots[SLOTS];
+
+        /// Positions only need to tell laps of one slot apart, so 30 bits suffice.
+        static constexpr uint32_t stamp(uint32_t position, uint32_t state)
+        {
+            return (position << 2) | state;
+        }
+    };
+
+} // namespace LogAnywhere
@@ -6,36 +6,242 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include "HandlerEntry.h"
 
-/// Each tag is ~112 bytes - Increasing this will increase memory usage.
+/// Each subscriber slot costs ~36 bytes per Tag (entry pointer plus the hot
+/// columns) - Increasing this will increase memory usage.
 #ifndef MAX_TAG_SUBSCRIPTIONS
 #define MAX_TAG_SUBSCRIPTIONS 12
 #endif
 
 namespace LogAnywhere {
 
+struct Tag;
+
+/**
+ * @brief The dispatch-critical data of one Tag's subscribers, as columns.
+ *
+ * Rows are sorted for dispatch (see Tag::rebuildDispatch()), not in
+ * subscriberList() order.  Dispatch reads only these arrays; the
+ * HandlerEntry (id, name, tag lists) stays cold.
+ */
+struct SubscriberColumns
+{
+    const HandlerEntry** entries;  ///< Entry of each row (statistics, latency)
+    HandlerGroups*       groups;   ///< Groups of each handler
+    LogHandler*          fns;      ///< Callbacks
+    void**               contexts; ///< Callback contexts
+};
+
+namespace detail {
+    /// Head of the list of every live Tag, newest first (linked through Tag::nextTag).
+    inline Tag* liveTags = nullptr;
+
+    /// Called at the end of every Tag constructor; installed by HandlerManager
+    /// so wildcard subscriptions pick up Tags created after registration.
+    inline void (*tagCreatedHook)(Tag*) = nullptr;
+
+    /// Rebuilds the dispatch lists of every Tag @p entry is subscribed to.
+    inline void refreshSubscriber(const HandlerEntry* entry);
+} // namespace detail
+
 /**
  * @brief A static tag with a built-in subscriber list.
  *
  * Each Tag instance carries its own fixed array of handler pointers
- * (up to MAX_TAG_SUBSCRIPTIONS), plus a count.
+ * (up to MAX_TAG_SUBSCRIPTIONS), plus a count.  From it the Tag derives
+ * one precomputed dispatch list per LogLevel holding exactly the enabled
+ * handlers that accept that level.  The lists share storage: the hot
+ * columns (see columns()) hold the enabled handlers sorted by threshold,
+ * so the list for level L is the first levelEnd[L] rows, and the disabled
+ * handlers follow after every list.  Dispatch walks one prefix without
+ * testing levels or enable flags.  With LOGANYWHERE_ENABLE_GROWABLE the
+ * `subscribers` pointer and the columns may move together to
+ * resource-backed storage to go past MAX_TAG_SUBSCRIPTIONS.
+ *
+ * Names may be dotted ("net.tcp.rx") so handlers can subscribe to a whole
+ * subtree with a wildcard pattern (see TagPattern.h).  To make that work
+ * every Tag links itself into a global list for its lifetime.  It is also
+ * registered in the TagRegistry (dense #id, lookup by name).  So Tags
+ * cannot be copied, and creating or destroying one must not race with
+ * handler registration.
  */
 struct Tag
 {
     const char*               name;         ///< Human-readable tag
     const HandlerEntry*       handlers[MAX_TAG_SUBSCRIPTIONS]; ///< Subscribers
     size_t                    handlerCount; ///< Number of valid entries
+    Tag*                      nextTag;      ///< Next live Tag (detail::liveTags list)
+    uint16_t                  id;           ///< Dense ID from the TagRegistry, 0 if it was full
+
+    uint16_t                  levelEnd[LOG_LEVEL_COUNT]; ///< Rows of the dispatch list for each level
+    uint16_t                  dispatchRows;              ///< Rows in the columns, disabled handlers included
+    HandlerGroups             dispatchGroups;            ///< Union of every row's groups
+
+    const HandlerEntry*       subscriberEntries[MAX_TAG_SUBSCRIPTIONS];  ///< Hot column: entries
+    HandlerGroups             subscriberGroups[MAX_TAG_SUBSCRIPTIONS];   ///< Hot column: groups
+    LogHandler                subscriberFns[MAX_TAG_SUBSCRIPTIONS];      ///< Hot column: callbacks
+    void*                     subscriberContexts[MAX_TAG_SUBSCRIPTIONS]; ///< Hot column: contexts
+
+#if LOGANYWHERE_ENABLE_GROWABLE
+    const HandlerEntry**      subscribers;  ///< Active subscriber list (handlers or grown storage)
+    SubscriberColumns         grownColumns; ///< Active columns when the list is grown
+    size_t                    subscriberCapacity; ///< Capacity of subscribers
+    const MemoryResource*     subscriberResource; ///< Owner of grown storage, nullptr when inline
+#endif
+
+#if LOGANYWHERE_ENABLE_STATS
+    mutable TagCounters       logged;       ///< Messages logged, by level and thread shard
+#endif
 
     /**
      * @brief Construct a Tag with a given name.
+     *
+     * Registers the Tag in the global TagRegistry (assigning #id), links it
+     * into the live list and joins matching wildcard subscriptions.
+     *
      * @param name_ The static, null-terminated C-string.
      */
-    Tag(const char* name_)
-        : name(name_), handlerCount(0)
+    Tag(const char* name_);
+
+    /**
+     * @brief Releases the Tag's ID and removes it from the live list.
+     *
+     * Handlers still subscribed are not notified; delete them or call
+     * HandlerManager::clearHandlers() first if they outlive the Tag.
+     */
+    ~Tag();
+
+    Tag(const Tag&) = delete;
+    Tag& operator=(const Tag&) = delete;
+
+    /// @return The subscriber array dispatch walks (handlerCount valid entries).
+    const HandlerEntry** subscriberList()
     {
-        // nothing else
+#if LOGANYWHERE_ENABLE_GROWABLE
+        return subscribers;
+#else
+        return handlers;
+#endif
+    }
+
+    /// @copydoc subscriberList()
+    const HandlerEntry* const* subscriberList() const
+    {
+#if LOGANYWHERE_ENABLE_GROWABLE
+        return subscribers;
+#else
+        return handlers;
+#endif
+    }
+
+    /// @return How many subscribers fit before the list is full.
+    size_t subscriberLimit() const
+    {
+#if LOGANYWHERE_ENABLE_GROWABLE
+        return subscriberCapacity;
+#else
+        return MAX_TAG_SUBSCRIPTIONS;
+#endif
+    }
+
+    /// @return The hot columns dispatch reads (dispatchRows valid rows each).
+    SubscriberColumns columns()
+    {
+#if LOGANYWHERE_ENABLE_GROWABLE
+        if (subscriberResource)
+            return grownColumns;
+#endif
+        return {subscriberEntries, subscriberGroups, subscriberFns, subscriberContexts};
+    }
+
+    /// @copydoc columns()
+    SubscriberColumns columns() const
+    {
+        // Dispatch only reads through the returned pointers
+        return const_cast<Tag*>(this)->columns();
+    }
+
+    /**
+     * @brief Recomputes the per-level dispatch lists from subscriberList().
+     *
+     * A stable counting sort by threshold: enabled handlers go first,
+     * lowest threshold first and in subscription order within a
+     * threshold, so levelEnd[L] rows cover exactly the enabled handlers
+     * whose threshold is <= L.  Disabled handlers fill the remaining rows.
+     * Runs on every registry change that affects this Tag.
+     */
+    void rebuildDispatch()
+    {
+        const HandlerEntry* const* list = subscriberList();
+        const SubscriberColumns c = columns();
+
+        size_t next[LOG_LEVEL_COUNT + 1] = {};
+        for (size_t i = 0; i < handlerCount; ++i)
+        {
+            if (list[i]->isEnabled())
+                ++next[static_cast<size_t>(list[i]->level) + 1];
+        }
+        for (size_t l = 1; l <= LOG_LEVEL_COUNT; ++l)
+            next[l] += next[l - 1];
+        for (size_t l = 0; l < LOG_LEVEL_COUNT; ++l)
+            levelEnd[l] = static_cast<uint16_t>(next[l + 1]);
+
+        size_t disabledRow = next[LOG_LEVEL_COUNT];
+        dispatchGroups = 0;
+        for (size_t i = 0; i < handlerCount; ++i)
+        {
+            const HandlerEntry* e = list[i];
+            const size_t row = e->isEnabled() ? next[static_cast<size_t>(e->level)]++ : disabledRow++;
+            c.entries[row] = e;
+            c.groups[row] = e->groups;
+            c.fns[row] = e->handler;
+            c.contexts[row] = e->context;
+            dispatchGroups |= e->groups;
+        }
+        dispatchRows = static_cast<uint16_t>(handlerCount);
+    }
+
+    /**
+     * @brief Rebuilds the dispatch lists if @p entry is a subscriber.
+     */
+    void refreshSubscriber(const HandlerEntry* entry)
+    {
+        const HandlerEntry* const* list = subscriberList();
+        for (size_t i = 0; i < handlerCount; ++i)
+        {
+            if (list[i] == entry)
+            {
+                rebuildDispatch();
+                return;
+            }
+        }
     }
 };
 
+namespace detail {
+    inline void refreshSubscriber(const HandlerEntry* entry)
+    {
+        for (Tag* t = liveTags; t; t = t->nextTag)
+            t->refreshSubscriber(entry);
+    }
+} // namespace detail
+
+// HandlerEntry's enable switches live here, where Tag is complete
+
+inline void HandlerEntry::setEnabled(bool on) noexcept
+{
+    enabled = on;
+    detail::refreshSubscriber(this);
+}
+
+inline void HandlerEntry::disable() noexcept
+{
+    setEnabled(false);
+}
+
 } // namespace LogAnywhere
+
+// Defines Tag's constructor and destructor
+#include "TagRegistry.h"
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file TagPattern.h
+ * @brief Matches dotted, hierarchical tag names against wildcard patterns.
+ *
+ * Tag names may be split into segments with '.', e.g. "net.tcp.rx".  A
+ * pattern uses the same segments, where a segment of exactly "*" matches
+ * any one segment, and a trailing "*" matches one or more segments:
+ *
+ *  - "net.tcp.rx" matches only "net.tcp.rx"
+ *  - "net.*.rx"   matches "net.tcp.rx" and "net.udp.rx"
+ *  - "net.*"      matches "net.tcp" and "net.tcp.rx", but not "net"
+ *  - "*"          matches every tag
+ *
+ * Patterns are only evaluated when a handler registers or a Tag is
+ * created (see HandlerManager::registerHandlerForPatterns()); dispatch
+ * never looks at them.
+ */
+
+#include <cstddef>
+#include <cstring>
+
+namespace LogAnywhere
+{
+
+    namespace detail
+    {
+        /// @return Length of the segment starting at @p s (up to '.' or '\0').
+        inline size_t segmentLength(const char *s)
+        {
+            size_t n = 0;
+            while (s[n] && s[n] != '.')
+                ++n;
+            return n;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Checks a dotted tag name against a wildcard pattern.
+     *
+     * @param pattern Pattern such as "net.*" or "net.*.rx".
+     * @param name    Tag name such as "net.tcp.rx".
+     * @return true if @p name matches @p pattern.
+     */
+    inline bool matchesTagPattern(const char *pattern, const char *name)
+    {
+        if (!pattern || !name)
+            return false;
+        for (;;)
+        {
+            const size_t p = detail::segmentLength(pattern);
+            const size_t n = detail::segmentLength(name);
+            const bool wildcard = p == 1 && pattern[0] == '*';
+
+            // A trailing "*" swallows the rest of the name (at least one segment)
+            if (wildcard && pattern[1] == '\0')
+                return n > 0;
+            if (wildcard ? n == 0 : (p != n || std::strncmp(pattern, name, p) != 0))
+                return false;
+
+            pattern += p;
+            name += n;
+            if (*pattern == '\0' || *name == '\0')
+                return *pattern == '\0' && *name == '\0';
+            ++pattern; // skip '.'
+            ++name;
+        }
+    }
+
+} // namespace LogAnywhere
@@ -0,0 +1,344 @@
+#pragma once
+
+/**
+ * @file TagRegistry.h
+ * @brief Global registry that gives every Tag a dense ID and finds Tags by name.
+ *
+ * Configuration files and remote commands name tags by string.  Every Tag
+ * registers itself here on construction and receives a small dense ID
+ * (1 .. LOGANYWHERE_MAX_TAGS, 0 if the registry is full); findTag() then
+ * maps a name back to the live Tag through an open-addressing hash table
+ * in O(1), and tagById() / tagName() map an ID back through a plain array.
+ *
+ * For a set of tag names fixed at compile time, PerfectTagHash builds a
+ * collision-free table in a constexpr context, so lookups cost one hash,
+ * one table read and one string compare, with no registry involved.
+ *
+ * The registry is not locked: creating or destroying Tags must not race
+ * with each other or with lookups, like handler registration.
+ */
+
+#include "Tag.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// Capacity of the global tag registry (live Tags with an ID and name lookup).
+#ifndef LOGANYWHERE_MAX_TAGS
+#define LOGANYWHERE_MAX_TAGS 64
+#endif
+
+namespace LogAnywhere
+{
+
+    namespace detail
+    {
+        /// FNV-1a over a C-string, with a seed mixed into the offset basis.
+        constexpr uint32_t tagHash(const char *s, uint32_t seed = 0)
+        {
+            uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+            while (*s)
+            {
+                h ^= static_cast<uint8_t>(*s++);
+                h *= 16777619u;
+            }
+            return h;
+        }
+
+        /// constexpr strcmp() == 0.
+        constexpr bool tagNameEquals(const char *a, const char *b)
+        {
+            while (*a && *a == *b)
+            {
+                ++a;
+                ++b;
+            }
+            return *a == *b;
+        }
+
+        /// @return Smallest power of two >= @p n (at least 1).
+        constexpr size_t nextPow2(size_t n)
+        {
+            size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Registry of live Tags: dense IDs plus a name hash table.
+     *
+     * IDs of destroyed Tags are reused by the next Tag, so IDs stay dense
+     * and usable as array indices (e.g. per-tag counters in a sink).
+     */
+    class TagRegistry
+    {
+    public:
+        static constexpr size_t MAX_TAGS = LOGANYWHERE_MAX_TAGS; ///< Registry capacity
+        static_assert(MAX_TAGS < UINT16_MAX, "tag IDs are 16-bit");
+
+        /**
+         * @brief Gives @p tag the lowest free ID and indexes its name.
+         *
+         * @param tag Tag being constructed.
+         * @return The new ID, or 0 if the registry is full.
+         */
+        uint16_t add(Tag *tag)
+        {
+            if (count == MAX_TAGS)
+                return 0;
+            uint16_t id = 1;
+            while (tags[id])
+                ++id;
+            tags[id] = tag;
+            ++count;
+            size_t slot = detail::tagHash(tag->name) & MASK;
+            while (buckets[slot])
+                slot = (slot + 1) & MASK;
+            buckets[slot] = id;
+            return id;
+        }
+
+        /**
+         * @brief Frees @p id and removes its name from the hash table.
+         *
+         * Uses backward-shift deletion, so no tombstones accumulate.
+         *
+         * @param id ID returned by add(); 0 is ignored.
+         */
+        void remove(uint16_t id)
+        {
+            if (id == 0 || id > MAX_TAGS || !tags[id])
+                return;
+            size_t slot = detail::tagHash(tags[id]->name) & MASK;
+            while (buckets[slot] != id)
+                slot = (slot + 1) & MASK;
+            // Pull later members of the probe run back over the hole
+            for (size_t next = (slot + 1) & MASK; buckets[next]; next = (next + 1) & MASK)
+            {
+                size_t home = detail::tagHash(tags[buckets[next]]->name) & MASK;
+                if (((next - home) & MASK) >= ((next - slot) & MASK))
+                {
+                    buckets[slot] = buckets[next];
+                    slot = next;
+                }
+            }
+            buckets[slot] = 0;
+            tags[id] = nullptr;
+            --count;
+        }
+
+        /**
+         * @brief Finds a live Tag by name.
+         *
+         * @param name Exact tag name.
+         * @return The Tag, or nullptr.  With duplicate names, the earliest
+         *         registered one still alive.
+         */
+        Tag *find(const char *name) const
+        {
+            if (!name)
+                return nullptr;
+            for (size_t slot = detail::tagHash(name) & MASK; buckets[slot]; slot = (slot + 1) & MASK)
+            {
+                Tag *tag = tags[buckets[slot]];
+                if (std::strcmp(tag->name, name) == 0)
+                    return tag;
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Maps a dense ID back to its Tag.
+         *
+         * @param id Tag ID.
+         * @return The Tag, or nullptr if @p id is free or out of range.
+         */
+        Tag *byId(uint16_t id) const
+        {
+            return id <= MAX_TAGS ? tags[id] : nullptr;
+        }
+
+        /// @return Number of registered Tags.
+        size_t size() const noexcept { return count; }
+
+    private:
+        static constexpr size_t BUCKETS = detail::nextPow2(MAX_TAGS * 2); ///< Load factor <= 0.5
+        static constexpr size_t MASK = BUCKETS - 1;
+
+        Tag *tags[MAX_TAGS + 1] = {};     ///< By ID; [0] is never used
+        uint16_t buckets[BUCKETS] = {};   ///< Tag IDs by name hash, 0 = empty
+        size_t count = 0;                 ///< Registered Tags
+    };
+
+    namespace detail
+    {
+        /// The process-wide registry (constant-initialized, so usable from static Tags).
+        inline TagRegistry tagRegistry;
+    } // namespace detail
+
+    /**
+     * @brief Finds a live Tag by name in O(1).
+     *
+     * @param name Exact tag name, e.g. from a config file.
+     * @return The Tag, or nullptr if none is registered under that name.
+     */
+    inline Tag *findTag(const char *name) { return detail::tagRegistry.find(name); }
+
+    /**
+     * @brief Maps a Tag ID (Tag::id) back to its Tag.
+     *
+     * @param id Dense tag ID.
+     * @return The Tag, or nullptr.
+     */
+    inline Tag *tagById(uint16_t id) { return detail::tagRegistry.byId(id); }
+
+    /**
+     * @brief Maps a Tag ID (e.g. LogMessage::tagId) to the Tag's name.
+     *
+     * @param id Dense tag ID.
+     * @return The name, or nullptr if no live Tag has that ID.
+     */
+    inline const char *tagName(uint16_t id)
+    {
+        const Tag *tag = tagById(id);
+        return tag ? tag->name : nullptr;
+    }
+
+    /**
+     * @brief Collision-free name → index table built at compile time.
+     *
+     * Uses hash-and-displace: names are spread over N buckets by one hash,
+     * then each bucket (largest first) gets the first seed that places all
+     * its names in free slots of a SIZE-slot table.  Lookup is
+     * slot = hash(name, seed[bucket]), then one compare against that slot.
+     *
+     * @code
+     * constexpr const char *kNames[] = {"net.tcp", "net.udp", "db"};
+     * constexpr PerfectTagHash<3> kTagIndex(kNames);
+     * static_assert(kTagIndex.find("db") == 2, "");
+     * @endcode
+     *
+     * @tparam N Number of names.
+     */
+    template <size_t N>
+    class PerfectTagHash
+    {
+    public:
+        static constexpr size_t SIZE = detail::nextPow2(N + N / 2 + 1); ///< Slots in the table
+        static constexpr size_t NOT_FOUND = N;                           ///< Returned by find() on a miss
+
+        /**
+         * @brief Builds the table; meant to run in a constexpr context.
+         *
+         * @param names N distinct tag names with static storage duration.
+         */
+        constexpr PerfectTagHash(const char *const (&names)[N])
+            : names_(names), seeds_{}, slots_{}
+        {
+            size_t bucketSize[N] = {};
+            for (size_t i = 0; i < N; ++i)
+                ++bucketSize[bucketOf(names[i])];
+
+            size_t largest = 0;
+            for (size_t b = 0; b < N; ++b)
+                largest = bucketSize[b] > largest ? bucketSize[b] : largest;
+
+            for (size_t size = largest; size > 0; --size)
+            {
+                for (size_t b = 0; b < N; ++b)
+                {
+                    if (bucketSize[b] == size)
+                        placeBucket(b);
+                }
+            }
+        }
+
+        /**
+         * @brief Finds the index of @p name in the constructor's array.
+         *
+         * @param name Tag name.
+         * @return Index in 0 .. N-1, or NOT_FOUND.
+         */
+        constexpr size_t find(const char *name) const
+        {
+            const uint32_t seed = seeds_[bucketOf(name)];
+            const uint16_t entry = slots_[detail::tagHash(name, seed) & (SIZE - 1)];
+            return entry && detail::tagNameEquals(names_[entry - 1], name) ? entry - 1 : NOT_FOUND;
+        }
+
+    private:
+        const char *const *names_; ///< Names passed to the constructor
+        uint32_t seeds_[N];        ///< Displacement seed per bucket (0 = unused)
+        uint16_t slots_[SIZE];     ///< Name index + 1 per slot, 0 = empty
+
+        static constexpr size_t bucketOf(const char *name) { return detail::tagHash(name) % N; }
+
+        /// Finds the first seed that puts every name of bucket @p b in a free, distinct slot.
+        constexpr void placeBucket(size_t b)
+        {
+            for (uint32_t seed = 1;; ++seed)
+            {
+                bool fits = true;
+                for (size_t i = 0; i < N && fits; ++i)
+                {
+                    if (bucketOf(names_[i]) != b)
+                        continue;
+                    const size_t slot = detail::tagHash(names_[i], seed) & (SIZE - 1);
+                    if (slots_[slot])
+                    {
+                        fits = false;
+                        break;
+                    }
+                    slots_[slot] = static_cast<uint16_t>(i + 1);
+                }
+                if (fits)
+                {
+                    seeds_[b] = seed;
+                    return;
+                }
+                // Undo the partial placement and try the next seed
+                for (size_t i = 0; i < N; ++i)
+                {
+                    if (bucketOf(names_[i]) == b)
+                    {
+                        const size_t slot = detail::tagHash(names_[i], seed) & (SIZE - 1);
+                        if (slots_[slot] == i + 1)
+                            slots_[slot] = 0;
+                    }
+                }
+            }
+        }
+    };
+
+    // Tag's constructor and destructor live here, where the registry is complete
+
+    inline Tag::Tag(const char *name_)
+        : name(name_), handlerCount(0), nextTag(detail::liveTags), id(0),
+          levelEnd{}, dispatchRows(0), dispatchGroups(0)
+#if LOGANYWHERE_ENABLE_GROWABLE
+        , subscribers(handlers), grownColumns{}, subscriberCapacity(MAX_TAG_SUBSCRIPTIONS), subscriberResource(nullptr)
+#endif
+    {
+        detail::liveTags = this;
+        id = detail::tagRegistry.add(this);
+        // Let wildcard subscriptions that match this name join it
+        if (detail::tagCreatedHook)
+            detail::tagCreatedHook(this);
+    }
+
+    inline Tag::~Tag()
+    {
+        detail::tagRegistry.remove(id);
+        for (Tag **link = &detail::liveTags; *link; link = &(*link)->nextTag)
+        {
+            if (*link == this)
+            {
+                *link = nextTag;
+                break;
+            }
+        }
+    }
+
+} // namespace LogAnywhere
@@ -0,0 +1,262 @@
+#pragma once
+
+/**
+ * @file ThreadContext.h
+ * @brief Per-thread logging state that is set up once and reused by every call.
+ *
+ * A ThreadContext holds what a logging thread would otherwise rebuild on
+ * each call:
+ *  - a format scratch buffer for logf() (LOGANYWHERE_FORMAT_SCRATCH bytes),
+ *  - the cached OS thread ID (currentCpu() gives the CPU just as cheaply),
+ *  - a block of sequence numbers reserved from a process-wide counter, so
+ *    contextSequence() touches shared memory once per block,
+ *  - a slot for a per-thread async buffer, released at thread exit.
+ *
+ * The context is created on first use and destroyed when the thread exits.
+ * After that (e.g. from another thread_local destructor) threadContext()
+ * returns nullptr and callers fall back to their stack-based path, so late
+ * log calls stay safe.
+ *
+ * Define LOGANYWHERE_ENABLE_THREAD_CONTEXT=1 to have Logger::logf() and
+ * LogAnywhere::logf() format into the scratch buffer.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "LogMessage.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <functional>
+#include <thread>
+#endif
+
+/// Size of the per-thread logf() scratch buffer.
+#ifndef LOGANYWHERE_FORMAT_SCRATCH
+#define LOGANYWHERE_FORMAT_SCRATCH 512
+#endif
+
+/// Sequence numbers a thread reserves at a time for contextSequence().
+#ifndef LOGANYWHERE_SEQUENCE_BLOCK
+#define LOGANYWHERE_SEQUENCE_BLOCK 64
+#endif
+
+namespace LogAnywhere
+{
+
+    /**
+     * @brief Logging state owned by one thread.
+     */
+    struct ThreadContext
+    {
+        /// Releases the async buffer attached to a context at thread exit.
+        using ReleaseFn = void (*)(void *buffer, void *context);
+
+        char scratch[LOGANYWHERE_FORMAT_SCRATCH]; ///< logf() format buffer
+        uint32_t scratchDepth = 0;                ///< Nested users of scratch (handlers calling logf)
+        uint64_t threadId = 0;                    ///< OS thread ID, read once
+        uint64_t sequenceNext = 0;                ///< Next number of the reserved block
+        uint64_t sequenceEnd = 0;                 ///< One past the reserved block
+
+        void *asyncBuffer = nullptr;              ///< Per-thread buffer of an async backend
+        ReleaseFn releaseAsyncBuffer = nullptr;   ///< Called with asyncBuffer at thread exit
+        void *releaseContext = nullptr;           ///< Passed to releaseAsyncBuffer
+
+        ThreadContext();
+        ~ThreadContext();
+
+        ThreadContext(const ThreadContext &) = delete;
+        ThreadContext &operator=(const ThreadContext &) = delete;
+
+        /**
+         * @brief Attaches an async buffer to this thread.
+         *
+         * @param buffer  Backend-specific per-thread buffer.
+         * @param release Called with (@p buffer, @p context) when the thread
+         *                exits; may be nullptr.
+         * @param context Passed through to @p release.
+         */
+        void attachAsyncBuffer(void *buffer, ReleaseFn release, void *context)
+        {
+            asyncBuffer = buffer;
+            releaseAsyncBuffer = release;
+            releaseContext = context;
+        }
+    };
+
+    namespace detail
+    {
+        /// Lifecycle of the calling thread's context; trivially destructible,
+        /// so it stays readable while other thread_locals are destroyed.
+        enum class ThreadContextState : uint8_t
+        {
+            None,
+            Live,
+            Destroyed
+        };
+
+        inline thread_local ThreadContextState threadContextState = ThreadContextState::None;
+
+        /// Process-wide source of sequence blocks.
+        inline std::atomic<uint64_t> sequenceSource{1};
+
+        /// @return The OS identifier of the calling thread.
+        inline uint64_t osThreadId()
+        {
+#if defined(__linux__)
+            return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+            return static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+        }
+
+        /// The calling thread's context object; constructed on first call.
+        inline ThreadContext &threadContextStorage()
+        {
+            static thread_local ThreadContext context;
+            return context;
+        }
+    } // namespace detail
+
+    inline ThreadContext::ThreadContext()
+        : threadId(detail::osThreadId())
+    {
+        detail::threadContextState = detail::ThreadContextState::Live;
+    }
+
+    inline ThreadContext::~ThreadContext()
+    {
+        detail::threadContextState = detail::ThreadContextState::Destroyed;
+        if (releaseAsyncBuffer)
+            releaseAsyncBuffer(asyncBuffer, releaseContext);
+        asyncBuffer = nullptr;
+    }
+
+    /**
+     * @brief Returns the calling thread's context, creating it on first use.
+     *
+     * @return The context, or nullptr once the thread is tearing it down.
+     */
+    inline ThreadContext *threadContext()
+    {
+        if (detail::threadContextState == detail::ThreadContextState::Destroyed)
+            return nullptr;
+        return &detail::threadContextStorage();
+    }
+
+    /**
+     * @brief Cached OS thread ID of the calling thread.
+     *
+     * @return The ID (queried once per thread; directly during teardown).
+     */
+    inline uint64_t contextThreadId()
+    {
+        ThreadContext *ctx = threadContext();
+        return ctx ? ctx->threadId : detail::osThreadId();
+    }
+
+#if defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+#define LOGANYWHERE_HAVE_RSEQ 1
+    extern "C" const ptrdiff_t __rseq_offset; // glibc: thread pointer -> struct rseq
+    extern "C" const unsigned int __rseq_size; // 0 if glibc did not register rseq
+#else
+#define LOGANYWHERE_HAVE_RSEQ 0
+#endif
+
+    /**
+     * @brief Returns the CPU the calling thread is running on.
+     *
+     * Reads rseq's cpu_id, which the kernel keeps current in the thread's
+     * registered rseq area (one load, no system call).  Without rseq it uses
+     * sched_getcpu(), which glibc serves from the vDSO.  The answer may be
+     * stale as soon as it is returned; it says where the thread ran.
+     *
+     * @return The CPU number, or UNKNOWN_CPU if it cannot be determined.
+     */
+    inline uint32_t currentCpu()
+    {
+#if LOGANYWHERE_HAVE_RSEQ
+        if (__rseq_size != 0)
+        {
+            // struct rseq { u32 cpu_id_start; u32 cpu_id; ... }
+            const char *area = static_cast<const char *>(__builtin_thread_pointer()) + __rseq_offset;
+            const int32_t cpu = *reinterpret_cast<const volatile int32_t *>(area + 4);
+            if (cpu >= 0)
+                return static_cast<uint32_t>(cpu);
+        }
+#endif
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        return cpu >= 0 ? static_cast<uint32_t>(cpu) : UNKNOWN_CPU;
+#else
+        return UNKNOWN_CPU;
+#endif
+    }
+
+    /**
+     * @brief Returns the next process-unique sequence number.
+     *
+     * Numbers come from a block of LOGANYWHERE_SEQUENCE_BLOCK reserved per
+     * thread, so they are unique but only increase within a thread.
+     * Matches Logger::TimestampFn, for use with setTimestampProvider().
+     *
+     * @return A sequence number, never 0.
+     */
+    inline uint64_t contextSequence()
+    {
+        ThreadContext *ctx = threadContext();
+        if (!ctx)
+            return detail::sequenceSource.fetch_add(1, std::memory_order_relaxed);
+        if (ctx->sequenceNext == ctx->sequenceEnd)
+        {
+            ctx->sequenceNext = detail::sequenceSource.fetch_add(LOGANYWHERE_SEQUENCE_BLOCK, std::memory_order_relaxed);
+            ctx->sequenceEnd = ctx->sequenceNext + LOGANYWHERE_SEQUENCE_BLOCK;
+        }
+        return ctx->sequenceNext++;
+    }
+
+    /**
+     * @brief Borrows the calling thread's scratch buffer for one format call.
+     *
+     * Falls back to nullptr (use a stack buffer) when the context is gone
+     * or the scratch is already in use further up the stack, e.g. by a
+     * handler that logs while its own message is being dispatched.
+     */
+    class ScratchLease
+    {
+    public:
+        ScratchLease()
+            : ctx(threadContext())
+        {
+            if (ctx && ctx->scratchDepth++ != 0)
+            {
+                --ctx->scratchDepth;
+                ctx = nullptr;
+            }
+        }
+
+        ~ScratchLease()
+        {
+            if (ctx)
+                --ctx->scratchDepth;
+        }
+
+        ScratchLease(const ScratchLease &) = delete;
+        ScratchLease &operator=(const ScratchLease &) = delete;
+
+        /// @return The scratch buffer, or nullptr if it is not available.
+        char *data() const noexcept { return ctx ? ctx->scratch : nullptr; }
+
+        /// @return Size of data() in bytes.
+        static constexpr size_t size() noexcept { return LOGANYWHERE_FORMAT_SCRATCH; }
+
+    private:
+        ThreadContext *ctx; ///< Context whose scratch is held, or nullptr
+    };
+
+} // namespace LogAnywhere
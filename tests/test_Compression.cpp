@@ -0,0 +1,200 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/Compression.h"
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+using namespace LogAnywhere;
+
+// Collects every frame emitted by a compressor into one contiguous stream.
+static void collectBytes(const uint8_t *data, size_t len, void *ctx)
+{
+    auto *out = static_cast<std::vector<uint8_t> *>(ctx);
+    out->insert(out->end(), data, data + len);
+}
+
+// Counts frames emitted by a compressor.
+static void countFrames(const uint8_t *, size_t, void *ctx)
+{
+    ++*static_cast<int *>(ctx);
+}
+
+// Builds a few KiB of typical log text.
+static std::string makeLogText(size_t lines)
+{
+    std::string text;
+    char line[128];
+    for (size_t i = 0; i < lines; ++i)
+    {
+        std::snprintf(line, sizeof(line),
+                      "[INFO] NET: connection %zu established to 10.0.0.%zu port 8883 rssi=-%zu\n",
+                      i, i % 250, 40 + i % 30);
+        text += line;
+    }
+    return text;
+}
+
+// Runs input through a compressor and back through a decompressor.
+static std::vector<uint8_t> roundTrip(const void *data, size_t len, size_t threshold,
+                                      std::vector<uint8_t> *framedOut = nullptr)
+{
+    std::vector<uint8_t> framed;
+    LzCompressor lz(collectBytes, &framed, threshold);
+    lz.write(data, len);
+    lz.flush();
+
+    std::vector<uint8_t> decoded;
+    LzDecompressor unlz(collectBytes, &decoded);
+    REQUIRE(unlz.feed(framed.data(), framed.size()));
+    if (framedOut)
+        *framedOut = framed;
+    return decoded;
+}
+
+// Tests lzCompressBlock / lzDecompressBlock as a standalone pair:
+// 1) tiny inputs below the match limit round-trip as pure literals
+// 2) highly repetitive input round-trips and shrinks
+// 3) malformed input is rejected instead of overrunning the output
+TEST_CASE("LZ block codec round-trips and validates input", "[Compression][block]")
+{
+    uint16_t table[1u << LOGANYWHERE_LZ_HASH_BITS];
+    uint8_t packed[lzCompressBound(4096)];
+    uint8_t unpacked[4096];
+
+    SECTION("tiny inputs round-trip as literals")
+    {
+        const char *small = "hello";
+        size_t n = lzCompressBlock(reinterpret_cast<const uint8_t *>(small), 5,
+                                   packed, sizeof(packed), table);
+        REQUIRE(n == 6); // token + 5 literals
+        REQUIRE(lzDecompressBlock(packed, n, unpacked, sizeof(unpacked)) == 5);
+        REQUIRE(std::memcmp(unpacked, small, 5) == 0);
+    }
+
+    SECTION("repetitive input shrinks and round-trips")
+    {
+        std::vector<uint8_t> src(4096, 'a');
+        size_t n = lzCompressBlock(src.data(), src.size(), packed, sizeof(packed), table);
+        REQUIRE(n > 0);
+        REQUIRE(n < 64);
+        REQUIRE(lzDecompressBlock(packed, n, unpacked, sizeof(unpacked)) == 4096);
+        REQUIRE(std::memcmp(unpacked, src.data(), src.size()) == 0);
+    }
+
+    SECTION("rejects undersized output and bad offsets")
+    {
+        std::vector<uint8_t> src(1024, 'b');
+        size_t n = lzCompressBlock(src.data(), src.size(), packed, sizeof(packed), table);
+        REQUIRE(lzDecompressBlock(packed, n, unpacked, 100) == -1);
+
+        const uint8_t badOffset[] = {0x10, 'x', 0x05, 0x00, 0x00};
+        REQUIRE(lzDecompressBlock(badOffset, sizeof(badOffset), unpacked, sizeof(unpacked)) == -1);
+    }
+
+    SECTION("refuses an output buffer smaller than the bound")
+    {
+        std::vector<uint8_t> src(256, 'c');
+        REQUIRE(lzCompressBlock(src.data(), src.size(), packed, 16, table) == 0);
+    }
+}
+
+// Tests the LzCompressor / LzDecompressor streaming stages:
+// 1) log text round-trips and compresses well
+// 2) incompressible bytes are framed as stored blocks
+// 3) the flush threshold sets frame granularity
+// 4) byte-at-a-time decoding matches bulk decoding
+// 5) a corrupted header puts the decoder in the error state
+TEST_CASE("LzCompressor streams framed blocks to a ByteSink", "[Compression][stream]")
+{
+    SECTION("log text round-trips with a high ratio")
+    {
+        std::string text = makeLogText(200);
+        std::vector<uint8_t> framed;
+        auto decoded = roundTrip(text.data(), text.size(), LzCompressor::BLOCK_SIZE, &framed);
+
+        REQUIRE(std::string(decoded.begin(), decoded.end()) == text);
+        REQUIRE(framed.size() * 3 < text.size());
+    }
+
+    SECTION("incompressible data is stored")
+    {
+        std::vector<uint8_t> noise(1500);
+        uint32_t x = 12345;
+        for (auto &b : noise)
+        {
+            x = x * 1103515245u + 12345u;
+            b = static_cast<uint8_t>(x >> 24);
+        }
+        std::vector<uint8_t> framed;
+        auto decoded = roundTrip(noise.data(), noise.size(), LzCompressor::BLOCK_SIZE, &framed);
+
+        REQUIRE(decoded == noise);
+        REQUIRE(framed.size() == noise.size() + LZ_FRAME_HEADER_SIZE);
+        REQUIRE((framed[3] & 0x80) != 0);
+    }
+
+    SECTION("flush threshold controls frame granularity")
+    {
+        int frames = 0;
+        LzCompressor lz(countFrames, &frames, 100);
+        std::string text = makeLogText(10);
+        lz.write(text.data(), text.size());
+
+        REQUIRE(frames == static_cast<int>(text.size() / 100));
+        REQUIRE(lz.pending() == text.size() % 100);
+        lz.flush();
+        REQUIRE(lz.pending() == 0);
+        REQUIRE(lz.bytesIn() == text.size());
+
+        lz.setFlushThreshold(0);
+        REQUIRE(lz.flushThreshold() == 1);
+        lz.setFlushThreshold(LzCompressor::BLOCK_SIZE * 4);
+        REQUIRE(lz.flushThreshold() == LzCompressor::BLOCK_SIZE);
+    }
+
+    SECTION("byte-at-a-time decoding matches")
+    {
+        std::string text = makeLogText(60);
+        std::vector<uint8_t> framed;
+        LzCompressor lz(collectBytes, &framed, 512);
+        lz.write(text.data(), text.size());
+        lz.flush();
+
+        std::vector<uint8_t> decoded;
+        LzDecompressor unlz(collectBytes, &decoded);
+        for (uint8_t b : framed)
+            REQUIRE(unlz.feed(&b, 1));
+        REQUIRE(std::string(decoded.begin(), decoded.end()) == text);
+    }
+
+    SECTION("short stored tail frames decode after compressed frames")
+    {
+        std::string text = makeLogText(12);
+        text += "tail";
+        auto decoded = roundTrip(text.data(), text.size(), text.size() - 4);
+        REQUIRE(std::string(decoded.begin(), decoded.end()) == text);
+    }
+
+    SECTION("compressor chains behind another stage via sinkAdapter")
+    {
+        std::vector<uint8_t> framed;
+        LzCompressor inner(collectBytes, &framed);
+        const char *msg = "chained chained chained chained chained";
+        LzCompressor::sinkAdapter(reinterpret_cast<const uint8_t *>(msg), std::strlen(msg), &inner);
+        REQUIRE(inner.pending() == std::strlen(msg));
+    }
+
+    SECTION("corrupted header is reported")
+    {
+        const uint8_t bogus[] = {0xFF, 0xFF, 0xFF, 0x7F, 0x00};
+        std::vector<uint8_t> decoded;
+        LzDecompressor unlz(collectBytes, &decoded);
+        REQUIRE_FALSE(unlz.feed(bogus, sizeof(bogus)));
+        REQUIRE(unlz.hasError());
+        unlz.reset();
+        REQUIRE_FALSE(unlz.hasError());
+    }
+}
@@ -0,0 +1,214 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/CrashHandler.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace LogAnywhere;
+
+// Runs @p body in a forked child, handing it the write end of a pipe as crash fd.
+// Returns the bytes written to the pipe and the child's wait status.
+template <typename Body>
+static std::string runCrashingChild(Body body, int &status)
+{
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        close(fds[0]);
+        body(fds[1]);
+        _exit(0); // body was expected to crash
+    }
+    close(fds[1]);
+    std::string out;
+    char buf[512];
+    ssize_t n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        out.append(buf, static_cast<size_t>(n));
+    close(fds[0]);
+    waitpid(pid, &status, 0);
+    return out;
+}
+
+// Crash flusher that writes a marker to the crash fd.
+static void markerFlush(const CrashInfo &info, void *ctx)
+{
+    const char *marker = static_cast<const char *>(ctx);
+    detail::writeFully(info.fd, marker, std::strlen(marker));
+}
+
+// Crash flusher that never returns; the alarm must still kill the process.
+static void hangingFlush(const CrashInfo &, void *)
+{
+    for (;;)
+        pause();
+}
+
+// Crash flusher that lets a second thread fault mid-flush, then finishes.
+static std::atomic<bool> flushStarted{false};
+static void slowFlush(const CrashInfo &info, void *)
+{
+    flushStarted.store(true);
+    struct timespec ts = {0, 200 * 1000 * 1000};
+    while (nanosleep(&ts, &ts) != 0)
+    {
+    }
+    detail::writeFully(info.fd, "slow-done;", 10);
+}
+
+// Collects decoded bytes from an LzDecompressor.
+static void collectBytes(const uint8_t *data, size_t len, void *ctx)
+{
+    static_cast<std::string *>(ctx)->append(reinterpret_cast<const char *>(data), len);
+}
+
+// Tests the fatal-signal emergency flush:
+// 1) SIGSEGV writes a crash record, runs flushers, and still dies by SIGSEGV
+// 2) abort() is reported as SIGABRT
+// 3) pending compressed bytes are flushed through a signal-safe fd sink
+// 4) a fault on another thread during the flush does not cut it short
+// 5) a wedged flusher is cut short by the alarm
+TEST_CASE("Crash handler flushes and re-raises fatal signals", "[CrashHandler]")
+{
+    SECTION("SIGSEGV record, flushers and exit status")
+    {
+        int status = 0;
+        std::string out = runCrashingChild([](int fd)
+                                           {
+            installCrashHandler(fd);
+            registerCrashFlush(markerFlush, const_cast<char *>("flushed-1;"));
+            registerCrashFlush(markerFlush, const_cast<char *>("flushed-2;"));
+            raise(SIGSEGV); }, status);
+
+        REQUIRE(WIFSIGNALED(status));
+        REQUIRE(WTERMSIG(status) == SIGSEGV);
+        REQUIRE(out.find("FATAL signal 11 (SIGSEGV)") != std::string::npos);
+        REQUIRE(out.find("flushed-1;flushed-2;") != std::string::npos);
+    }
+
+    SECTION("abort is reported as SIGABRT")
+    {
+        int status = 0;
+        std::string out = runCrashingChild([](int fd)
+                                           {
+            installCrashHandler(fd);
+            std::abort(); }, status);
+
+        REQUIRE(WIFSIGNALED(status));
+        REQUIRE(WTERMSIG(status) == SIGABRT);
+        REQUIRE(out.find("(SIGABRT)") != std::string::npos);
+    }
+
+    SECTION("pending compressor bytes reach the fd")
+    {
+        int status = 0;
+        std::string framed = runCrashingChild([](int fd)
+                                              {
+            installCrashHandler(-1);
+            static LzCompressor lz(fdByteSink, fdSinkContext(fd));
+            lz.write("queued before crash ", 20);
+            registerCrashFlush(crashFlushCompressor, &lz);
+            raise(SIGBUS); }, status);
+
+        REQUIRE(WTERMSIG(status) == SIGBUS);
+        std::string decoded;
+        LzDecompressor unlz(collectBytes, &decoded);
+        REQUIRE(unlz.feed(framed.data(), framed.size()));
+        REQUIRE(decoded.find("queued before crash FATAL signal") == 0);
+        REQUIRE(decoded.find("(SIGBUS)") != std::string::npos);
+    }
+
+    SECTION("a second thread faulting mid-flush waits for the flush")
+    {
+        int status = 0;
+        std::string out = runCrashingChild([](int fd)
+                                           {
+            installCrashHandler(fd);
+            registerCrashFlush(slowFlush, nullptr);
+            std::thread([]
+                        {
+                while (!flushStarted.load())
+                    sched_yield();
+                raise(SIGSEGV); })
+                .detach();
+            std::abort(); }, status);
+
+        REQUIRE(WIFSIGNALED(status));
+        REQUIRE(WTERMSIG(status) == SIGABRT);
+        REQUIRE(out.find("slow-done;") != std::string::npos);
+        REQUIRE(out.find("(SIGSEGV)") == std::string::npos);
+    }
+
+    SECTION("a hanging flusher is bounded by the timeout")
+    {
+        int status = 0;
+        runCrashingChild([](int fd)
+                         {
+            installCrashHandler(fd, 1);
+            registerCrashFlush(hangingFlush, nullptr);
+            raise(SIGFPE); }, status);
+
+        REQUIRE(WIFSIGNALED(status));
+        REQUIRE(WTERMSIG(status) == SIGALRM);
+    }
+}
+
+// Verifies crash records are appended to a PersistentRing
+TEST_CASE("Crash handler appends a record to a PersistentRing", "[CrashHandler][PersistentRing]")
+{
+    std::string path = "/tmp/loganywhere_crash_" + std::to_string(getpid()) + ".ring";
+    std::remove(path.c_str());
+
+    int status = 0;
+    runCrashingChild([&](int fd)
+                     {
+        static PersistentRing ring;
+        ring.open(path.c_str(), 16);
+        installCrashHandler(fd);
+        registerCrashFlush(crashFlushPersistentRing, &ring);
+        raise(SIGILL); }, status);
+    REQUIRE(WTERMSIG(status) == SIGILL);
+
+    PersistentRing ring;
+    REQUIRE(ring.open(path.c_str(), 16));
+    REQUIRE(ring.lastId() == 1);
+
+    uint8_t buf[PersistentRing::DEFAULT_SLOT_SIZE];
+    size_t len = 0;
+    REQUIRE(ring.read(1, buf, sizeof(buf), len));
+    PersistentLogRecord rec;
+    REQUIRE(PersistentRing::decodeMessage(buf, len, rec));
+    REQUIRE(rec.level == LogLevel::ERR);
+    REQUIRE(std::string(rec.tag, rec.tagLen) == "CRASH");
+    REQUIRE(std::string(rec.message, rec.messageLen).find("(SIGILL)") != std::string::npos);
+
+    ring.close();
+    std::remove(path.c_str());
+}
+
+// Verifies flusher slot bookkeeping
+TEST_CASE("registerCrashFlush respects capacity and unregistration", "[CrashHandler][registry]")
+{
+    int ctx[LOGANYWHERE_MAX_CRASH_FLUSHERS + 1];
+    for (int i = 0; i < LOGANYWHERE_MAX_CRASH_FLUSHERS; ++i)
+        REQUIRE(registerCrashFlush(markerFlush, &ctx[i]));
+    REQUIRE_FALSE(registerCrashFlush(markerFlush, &ctx[LOGANYWHERE_MAX_CRASH_FLUSHERS]));
+
+    REQUIRE(unregisterCrashFlush(markerFlush, &ctx[0]));
+    REQUIRE_FALSE(unregisterCrashFlush(markerFlush, &ctx[0]));
+    REQUIRE(registerCrashFlush(markerFlush, &ctx[LOGANYWHERE_MAX_CRASH_FLUSHERS]));
+
+    for (int i = 1; i <= LOGANYWHERE_MAX_CRASH_FLUSHERS; ++i)
+        REQUIRE(unregisterCrashFlush(markerFlush, &ctx[i]));
+}
@@ -0,0 +1,275 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#define LOGANYWHERE_ENABLE_GROWABLE 1
+#include "../include/LogAnywhere.h"
+#include "../include/PmrResource.h"
+#include "../include/RoutingTransaction.h"
+
+#include <string>
+#include <vector>
+
+using namespace LogAnywhere;
+
+static void countingHandler(const LogMessage &, void *ctx)
+{
+    ++*static_cast<int *>(ctx);
+}
+
+// Tests the growable HandlerManager on an arena:
+// 1) registers far more handlers than LOGANYWHERE_MAX_HANDLERS, all on one Tag
+//    beyond MAX_TAG_SUBSCRIPTIONS, and every one is dispatched to
+// 2) live entries never move when others are deleted or added
+// 3) deleted slots are reused and an emptied Tag returns to inline storage
+// 4) clearHandlers releases everything
+TEST_CASE("Growable HandlerManager grows past the static limits", "[GrowableRegistry]")
+{
+    alignas(std::max_align_t) static unsigned char buffer[256 * 1024];
+    ArenaResource arena(buffer, sizeof(buffer));
+    MemoryResource memory = arena.resource();
+    HandlerManager mgr(memory);
+    Logger logger(&mgr);
+    Tag BULK("BULK");
+    const Tag *tags[] = {&BULK};
+    constexpr int N = 200;
+    static int hits[N];
+    for (int &h : hits)
+        h = 0;
+
+    REQUIRE(mgr.isGrowable());
+    for (int i = 0; i < N; ++i)
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits[i], tags, 1));
+    REQUIRE(mgr.registeredCount() == N);
+    REQUIRE(BULK.handlerCount == N);
+    REQUIRE(BULK.subscribers != BULK.handlers);
+
+    SECTION("every handler is dispatched to")
+    {
+        logger.log(LogLevel::INFO, &BULK, "fan out");
+        for (int i = 0; i < N; ++i)
+            REQUIRE(hits[i] == 1);
+        for (size_t i = 0; i < mgr.registeredCount(); ++i)
+            REQUIRE(mgr.handlerAt(i)->id == i + 1);
+        size_t listed = 99;
+        mgr.listHandlers(listed);
+        REQUIRE(listed == 0);
+    }
+
+    SECTION("live entries keep their address")
+    {
+        std::vector<const HandlerEntry *> before;
+        for (size_t i = 0; i < mgr.registeredCount(); ++i)
+            before.push_back(mgr.handlerAt(i));
+
+        for (uint16_t id = 1; id <= N; id += 2)
+            REQUIRE(mgr.deleteHandlerByID(id));
+        for (int i = 0; i < N; ++i)
+            REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits[i], tags, 1));
+
+        // Survivors (even IDs) are still in order and at the same address
+        for (size_t i = 0; i < N / 2; ++i)
+        {
+            REQUIRE(mgr.handlerAt(i) == before[2 * i + 1]);
+            REQUIRE(mgr.handlerAt(i)->id == 2 * i + 2);
+        }
+        REQUIRE(mgr.registeredCount() == N + N / 2);
+        logger.log(LogLevel::INFO, &BULK, "after churn");
+        REQUIRE(hits[0] == 1);
+        REQUIRE(hits[1] == 2);
+    }
+
+    SECTION("freed slots are reused and emptied Tags return inline")
+    {
+        size_t used = arena.used();
+        for (uint16_t id = 1; id <= N; ++id)
+            REQUIRE(mgr.deleteHandlerByID(id));
+        REQUIRE(BULK.handlerCount == 0);
+        REQUIRE(BULK.subscribers == BULK.handlers);
+
+        for (int i = 0; i < N / 2; ++i)
+            REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits[i], nullptr, 0));
+        REQUIRE(arena.used() == used);
+    }
+
+    SECTION("clearHandlers releases everything")
+    {
+        mgr.clearHandlers();
+        REQUIRE(mgr.registeredCount() == 0);
+        REQUIRE(BULK.handlerCount == 0);
+        REQUIRE(BULK.subscribers == BULK.handlers);
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits[0], tags, 1));
+        REQUIRE(mgr.handlerAt(0)->id == 1);
+    }
+}
+
+TEST_CASE("Growable HandlerManager fails cleanly when memory runs out", "[GrowableRegistry]")
+{
+    alignas(std::max_align_t) static unsigned char buffer[4096];
+    ArenaResource arena(buffer, sizeof(buffer));
+    MemoryResource memory = arena.resource();
+    HandlerManager mgr(memory);
+    int hits = 0;
+
+    size_t registered = 0;
+    while (registered < 10000 &&
+           mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, nullptr, 0))
+        ++registered;
+    REQUIRE(registered >= LOGANYWHERE_MAX_HANDLERS);
+    REQUIRE(registered < 10000);
+    REQUIRE(mgr.registeredCount() == registered);
+}
+
+TEST_CASE("Growable HandlerManager works with std::pmr resources", "[GrowableRegistry]")
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    MemoryResource memory = pmrResource(&pool);
+    Tag T("PMR");
+    const Tag *tags[] = {&T};
+    int hits = 0;
+    {
+        HandlerManager mgr(memory);
+        Logger logger(&mgr);
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, tags, 1));
+        logger.log(LogLevel::INFO, &T, "pmr");
+        REQUIRE(hits == 100);
+        mgr.clearHandlers();
+    }
+    REQUIRE(T.subscribers == T.handlers);
+}
+
+// Tests that handler IDs stay unique once the 16-bit counter wraps:
+// 0 is never handed out and an ID still held by a live handler is skipped
+TEST_CASE("Growable HandlerManager IDs survive wrap-around", "[GrowableRegistry]")
+{
+    alignas(std::max_align_t) static unsigned char buffer[16 * 1024];
+    ArenaResource arena(buffer, sizeof(buffer));
+    HandlerManager mgr(arena.resource());
+    Logger logger(&mgr);
+    Tag T("WRAP");
+    const Tag *tags[] = {&T};
+    int keeperHits = 0, churnHits = 0;
+
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &keeperHits, tags, 1, "keeper"));
+    const uint16_t keeperId = mgr.handlerAt(0)->id;
+    for (int i = 0; i < 70000; ++i)
+    {
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &churnHits, tags, 1));
+        uint16_t id = mgr.handlerAt(1)->id;
+        REQUIRE(id != 0);
+        REQUIRE(id != keeperId);
+        REQUIRE(mgr.deleteHandlerByID(id));
+    }
+
+    REQUIRE(mgr.registeredCount() == 1);
+    REQUIRE(mgr.handlerAt(0)->id == keeperId);
+    logger.log(LogLevel::INFO, &T, "still routed");
+    REQUIRE(keeperHits == 1);
+    REQUIRE(churnHits == 0);
+}
+
+// Tests growable mode around the per-Tag and per-handler limits:
+// 1) add/delete churn at the Tag limit does not allocate again
+// 2) a failed Tag growth fails the registration and rolls it back
+// 3) a handler may subscribe to more than MAX_TAG_SUBSCRIPTIONS Tags
+// 4) handlerAt gives mutable access for enable/disable
+TEST_CASE("Growable HandlerManager limits, rollback and wide handlers", "[GrowableRegistry]")
+{
+    alignas(std::max_align_t) static unsigned char buffer[32 * 1024];
+    ArenaResource arena(buffer, sizeof(buffer));
+    HandlerManager mgr(arena.resource());
+    Logger logger(&mgr);
+    Tag T("EDGE");
+    const Tag *tags[] = {&T};
+    int hits = 0;
+
+    SECTION("churn at the Tag limit keeps the grown list")
+    {
+        for (size_t i = 0; i < MAX_TAG_SUBSCRIPTIONS + 1; ++i)
+            REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, tags, 1, i == 0 ? "last" : nullptr));
+        const size_t used = arena.used();
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(mgr.deleteHandlerByName("last"));
+            REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, tags, 1, "last"));
+        }
+        REQUIRE(arena.used() == used);
+        REQUIRE(T.handlerCount == MAX_TAG_SUBSCRIPTIONS + 1);
+    }
+
+    SECTION("a Tag that cannot grow fails the registration")
+    {
+        for (size_t i = 0; i < MAX_TAG_SUBSCRIPTIONS; ++i)
+            REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, tags, 1));
+        // Leave room for the directory and entry but not for the grown list
+        void *rest = arena.resource().allocateBytes(arena.remaining(), 1);
+        REQUIRE(rest != nullptr);
+
+        Tag Other("OTHER");
+        const Tag *both[] = {&Other, &T};
+        REQUIRE_FALSE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, both, 2, "late"));
+        REQUIRE(mgr.registeredCount() == MAX_TAG_SUBSCRIPTIONS);
+        REQUIRE(T.handlerCount == MAX_TAG_SUBSCRIPTIONS);
+        REQUIRE(Other.handlerCount == 0);
+        REQUIRE_FALSE(mgr.deleteHandlerByName("late"));
+
+        logger.log(LogLevel::INFO, &T, "unchanged");
+        REQUIRE(hits == static_cast<int>(MAX_TAG_SUBSCRIPTIONS));
+    }
+
+    SECTION("a handler subscribes to more Tags than tagList holds")
+    {
+        constexpr size_t WIDE = MAX_TAG_SUBSCRIPTIONS + 5;
+        static Tag *wide[WIDE];
+        const Tag *list[WIDE];
+        for (size_t i = 0; i < WIDE; ++i)
+            list[i] = wide[i] = new Tag("WIDE");
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, list, WIDE, "wide"));
+        REQUIRE(mgr.handlerAt(0)->tagCount == WIDE);
+        logger.log(LogLevel::INFO, wide[WIDE - 1], "last tag");
+        REQUIRE(hits == 1);
+
+        REQUIRE(mgr.deleteHandlerByName("wide"));
+        for (Tag *t : wide)
+        {
+            REQUIRE(t->handlerCount == 0);
+            delete t;
+        }
+    }
+
+    SECTION("handlerAt allows enabling and disabling")
+    {
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, tags, 1));
+        mgr.handlerAt(0)->setEnabled(false);
+        logger.log(LogLevel::INFO, &T, "muted");
+        REQUIRE(hits == 0);
+        mgr.handlerAt(0)->setEnabled(true);
+        logger.log(LogLevel::INFO, &T, "audible");
+        REQUIRE(hits == 1);
+    }
+}
+
+// Tests RoutingTransaction on a growable manager: when memory runs out
+// mid-commit, the registrations are undone and staged deletions never ran
+TEST_CASE("RoutingTransaction rolls back on a growable manager", "[GrowableRegistry][RoutingTransaction]")
+{
+    alignas(std::max_align_t) static unsigned char buffer[32 * 1024];
+    ArenaResource arena(buffer, sizeof(buffer));
+    HandlerManager mgr(arena.resource());
+    Tag T("TX");
+    const Tag *tags[] = {&T};
+    int hits = 0;
+
+    for (size_t i = 0; i < MAX_TAG_SUBSCRIPTIONS; ++i)
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &hits, tags, 1, i == 0 ? "first" : nullptr));
+    REQUIRE(arena.resource().allocateBytes(arena.remaining(), 1) != nullptr);
+
+    RoutingTransaction tx(mgr);
+    REQUIRE(tx.deleteHandler("first"));
+    REQUIRE(tx.registerHandler(LogLevel::TRACE, countingHandler, &hits, tags, 1, "n1"));
+    REQUIRE(tx.registerHandler(LogLevel::TRACE, countingHandler, &hits, tags, 1, "n2"));
+    REQUIRE_FALSE(tx.commit());
+    REQUIRE(mgr.registeredCount() == MAX_TAG_SUBSCRIPTIONS);
+    REQUIRE(T.handlerCount == MAX_TAG_SUBSCRIPTIONS);
+    REQUIRE(std::string(mgr.handlerAt(0)->name) == "first");
+}
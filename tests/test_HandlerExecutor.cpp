@@ -0,0 +1,139 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+#include "../include/HandlerExecutor.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+
+struct Recorder
+{
+    std::vector<uint64_t> timestamps;       // only touched by the lane's current worker
+    std::atomic<int> active{0};
+    bool overlapped = false;
+    std::chrono::microseconds delay{0};
+    std::mutex threadsLock;
+    std::set<std::thread::id> threads;
+};
+
+static void record(const LogMessage &msg, void *ctx)
+{
+    auto *r = static_cast<Recorder *>(ctx);
+    if (r->active.fetch_add(1) != 0)
+        r->overlapped = true;
+    r->timestamps.push_back(msg.timestamp);
+    if (r->delay.count())
+        std::this_thread::sleep_for(r->delay);
+    {
+        std::lock_guard<std::mutex> guard(r->threadsLock);
+        r->threads.insert(std::this_thread::get_id());
+    }
+    r->active.fetch_sub(1);
+}
+
+// Tests ordering guarantees with several workers and submitters:
+// 1) each handler gets every message in submission order
+// 2) a handler is never invoked concurrently with itself
+TEST_CASE("HandlerExecutor preserves per-handler order", "[HandlerExecutor]")
+{
+    static HandlerExecutor pool;
+    constexpr int HANDLERS = 6;
+    constexpr int PER_HANDLER = 2000;
+    Recorder rec[HANDLERS];
+    int lanes[HANDLERS];
+    for (int h = 0; h < HANDLERS; ++h)
+    {
+        lanes[h] = pool.addHandler(record, &rec[h]);
+        REQUIRE(lanes[h] == h);
+    }
+    REQUIRE(pool.lane(HANDLERS) == nullptr);
+    REQUIRE(pool.start(4));
+    REQUIRE_FALSE(pool.start(2));
+
+    // Two submitters, each owning three handlers, so per-handler order is defined
+    std::vector<std::thread> submitters;
+    for (int s = 0; s < 2; ++s)
+    {
+        submitters.emplace_back([s, &lanes]
+                                {
+                                    for (int i = 1; i <= PER_HANDLER; ++i)
+                                        for (int h = s; h < HANDLERS; h += 2)
+                                            while (!pool.submit(*pool.lane(lanes[h]), LogMessage(LogLevel::INFO, "T", "m", i)))
+                                                std::this_thread::yield(); });
+    }
+    for (auto &t : submitters)
+        t.join();
+    pool.stop();
+
+    for (int h = 0; h < HANDLERS; ++h)
+    {
+        REQUIRE(rec[h].timestamps.size() == PER_HANDLER);
+        bool inOrder = true;
+        for (int i = 0; i < PER_HANDLER; ++i)
+            inOrder = inOrder && rec[h].timestamps[i] == uint64_t(i + 1);
+        REQUIRE(inOrder);
+        REQUIRE_FALSE(rec[h].overlapped);
+    }
+}
+
+// Tests stealing: every lane has the same home worker, so the other
+// workers only get work by stealing it
+TEST_CASE("Idle workers steal lanes from a busy worker", "[HandlerExecutor]")
+{
+    static HandlerExecutor pool;
+    constexpr int WORKERS = 4;
+    constexpr int HANDLERS = WORKERS * 2;
+    Recorder rec[HANDLERS];
+    for (int h = 0; h < HANDLERS; ++h)
+    {
+        rec[h].delay = std::chrono::microseconds(500);
+        pool.addHandler(record, &rec[h]);
+    }
+    REQUIRE(pool.start(WORKERS));
+
+    // Lanes 0 and 4 are homed on worker 0; give only them work, then more
+    for (int i = 1; i <= 20; ++i)
+    {
+        pool.submit(*pool.lane(0), LogMessage(LogLevel::INFO, "T", "m", i));
+        pool.submit(*pool.lane(WORKERS), LogMessage(LogLevel::INFO, "T", "m", i));
+    }
+    pool.stop();
+
+    REQUIRE(rec[0].timestamps.size() == 20);
+    REQUIRE(rec[WORKERS].timestamps.size() == 20);
+    REQUIRE(pool.dropped() == 0);
+    REQUIRE(pool.steals() > 0);
+    std::set<std::thread::id> workers = rec[0].threads;
+    workers.insert(rec[WORKERS].threads.begin(), rec[WORKERS].threads.end());
+    REQUIRE(workers.size() > 1);
+}
+
+// Tests the LogHandler adapter: handlers registered through lanes receive
+// Logger output off the calling thread
+TEST_CASE("laneHandler moves dispatch onto the pool", "[HandlerExecutor]")
+{
+    static HandlerExecutor pool;
+    Recorder slow;
+    const int lane = pool.addHandler(record, &slow);
+    REQUIRE(pool.start(2));
+
+    Tag APP("APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::INFO, HandlerExecutor::laneHandler, pool.lane(lane), tags, 1));
+    for (int i = 1; i <= 10; ++i)
+        logger.log(LogLevel::WARN, &APP, "async", i);
+    pool.stop();
+
+    REQUIRE(slow.timestamps.size() == 10);
+    REQUIRE(slow.threads.count(std::this_thread::get_id()) == 0);
+}
@@ -0,0 +1,67 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#define LOGANYWHERE_ENABLE_STATS 1
+#include "../include/LogAnywhere.h"
+
+using namespace LogAnywhere;
+
+static void countingHandler(const LogMessage &, void *ctx)
+{
+    ++*static_cast<int *>(ctx);
+}
+
+static constexpr HandlerGroups NETWORK = handlerGroup(0);
+static constexpr HandlerGroups DEBUG_SINKS = handlerGroup(1);
+
+// Tests handler groups:
+// 1) disabling a group silences all of its handlers, others keep receiving
+// 2) a handler in several groups is skipped while any of them is disabled
+// 3) handlers without groups ignore group switches; skips count as disabled
+TEST_CASE("Handler groups are switched with one mask", "[HandlerGroups]")
+{
+    Tag APP("APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    int mqtt = 0, tcp = 0, trace = 0, serial = 0;
+
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &mqtt, tags, 1, "mqtt"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &tcp, tags, 1, "tcp"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &trace, tags, 1, "trace"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &serial, tags, 1, "serial"));
+    REQUIRE(mgr.setHandlerGroups("mqtt", NETWORK));
+    REQUIRE(mgr.setHandlerGroups("tcp", NETWORK | DEBUG_SINKS));
+    REQUIRE(mgr.setHandlerGroups(static_cast<uint16_t>(3), DEBUG_SINKS));
+    REQUIRE_FALSE(mgr.setHandlerGroups("missing", NETWORK));
+    REQUIRE(mgr.enabledGroups() == ~HandlerGroups(0));
+
+    mgr.disableGroups(NETWORK);
+    logger.log(LogLevel::INFO, &APP, "no network");
+    REQUIRE(mqtt == 0);
+    REQUIRE(tcp == 0);
+    REQUIRE(trace == 1);
+    REQUIRE(serial == 1);
+
+    mgr.enableGroups(NETWORK);
+    mgr.disableGroups(DEBUG_SINKS);
+    logger.log(LogLevel::INFO, &APP, "no debug");
+    REQUIRE(mqtt == 1);
+    REQUIRE(tcp == 0);
+    REQUIRE(trace == 1);
+    REQUIRE(serial == 2);
+
+    mgr.setEnabledGroups(0);
+    logger.log(LogLevel::INFO, &APP, "only ungrouped");
+    REQUIRE(serial == 3);
+    REQUIRE(mqtt + tcp + trace == 2);
+    REQUIRE(mgr.snapshotStats().droppedByDisabled == 2 + 2 + 3);
+
+    // Membership moves with the entry when an earlier handler is deleted
+    mgr.setEnabledGroups(~DEBUG_SINKS);
+    REQUIRE(mgr.deleteHandlerByName("mqtt"));
+    logger.log(LogLevel::INFO, &APP, "after delete");
+    REQUIRE(tcp == 0);
+    REQUIRE(trace == 1);
+    REQUIRE(serial == 4);
+}
@@ -2,6 +2,7 @@
 #include "catch.hpp"
 
 #include "../include/LogAnywhere.h"
+#include "../include/RoutingTransaction.h"
 
 #include <string>
 #include <sstream>
@@ -55,7 +56,7 @@ inline void clearAndVerify()
 // Tests HandlerManager::clearHandlers behavior:
 // 1) “registry is empty afterwards” — all handlers are removed, pointer remains valid
 // 2) “ID counter resets to 1” — new registrations restart at ID 1
-// 3) “does not prune Tag subscriptions” — tags retain their subscriber lists
+// 3) “prunes Tag subscriptions” — tags no longer point at wiped entries
 TEST_CASE("HandlerManager::clearHandlers behaves correctly",
           "[HandlerManager][clearHandlers]")
 {
@@ -96,16 +97,16 @@ TEST_CASE("HandlerManager::clearHandlers behaves correctly",
         REQUIRE(ptr[0].id == 1);
     }
 
-    // SECTION 3: “does not prune Tag subscriptions” — tags retain their subscriber lists
-    SECTION("does not prune Tag subscriptions")
+    // SECTION 3: “prunes Tag subscriptions” — tags no longer point at wiped entries
+    SECTION("prunes Tag subscriptions")
     {
         // Subscribe one handler to the DEFAULT tag
         handlerManager.registerHandlerForTags(LogLevel::INFO, dummyHandler, nullptr, tags, 1);
         REQUIRE(TAG_DEFAULT.handlerCount == 1); // subscription present
 
-        // Clear the registry (tags are unaffected)
+        // Clear the registry (subscriptions go with it)
         handlerManager.clearHandlers();
-        REQUIRE(TAG_DEFAULT.handlerCount == 1); // tag subscription remains
+        REQUIRE(TAG_DEFAULT.handlerCount == 0); // no dangling subscriber left
     }
 }
 
@@ -549,3 +550,85 @@ TEST_CASE("HandlerManager::findEntryByName via public API",
         REQUIRE(count == 1);
     }
 }
+
+// Regression: compaction moves entries down one slot; the Tags they subscribed
+// to must follow, otherwise a later registration reusing the old last slot is
+// reached twice and the moved handler is lost.
+TEST_CASE("HandlerManager compaction keeps Tag subscriptions on the moved entries",
+          "[HandlerManager][deleteHandlerByID]")
+{
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    Tag T("COMPACT");
+    const Tag *tags[] = {&T};
+    int a = 0, b = 0, c = 0;
+
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &a, tags, 1, "A"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &b, tags, 1, "B"));
+    REQUIRE(mgr.deleteHandlerByName("A"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &c, tags, 1, "C"));
+
+    size_t count = 0;
+    const HandlerEntry *entries = mgr.listHandlers(count);
+    REQUIRE(count == 2);
+    REQUIRE(T.handlerCount == 2);
+    REQUIRE(T.handlers[0] == &entries[0]);
+    REQUIRE(T.handlers[1] == &entries[1]);
+
+    logger.log(LogLevel::INFO, &T, "once each");
+    REQUIRE(a == 0);
+    REQUIRE(b == 1);
+    REQUIRE(c == 1);
+}
+
+// Tests the precomputed per-level dispatch lists:
+// 1) registration and compaction keep exactly the enabled handlers that
+//    accept each level, sorted by threshold
+// 2) setEnabled(), setHandlerGroups() and a transaction's setLevel() rebuild them
+TEST_CASE("Tag dispatch lists hold the handlers of each level", "[HandlerManager][Tag]")
+{
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    Tag T("COLUMNS");
+    const Tag *tags[] = {&T};
+    int a = 0, b = 0, c = 0;
+
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &a, tags, 1, "A"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::WARN, countingHandler, &b, tags, 1, "B"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::INFO, countingHandler, &c, tags, 1, "C"));
+    REQUIRE(mgr.deleteHandlerByName("A"));
+
+    SubscriberColumns hot = T.columns();
+    REQUIRE(T.dispatchRows == 2);
+    REQUIRE(T.levelEnd[static_cast<size_t>(LogLevel::DEBUG)] == 0);
+    REQUIRE(T.levelEnd[static_cast<size_t>(LogLevel::INFO)] == 1);
+    REQUIRE(T.levelEnd[static_cast<size_t>(LogLevel::ERR)] == 2);
+    REQUIRE(hot.contexts[0] == &c); // lower threshold first
+    REQUIRE(hot.contexts[1] == &b);
+    REQUIRE(hot.fns[1] == &countingHandler);
+    REQUIRE(hot.entries[1] == mgr.handlerAt(0));
+
+    mgr.handlerAt(0)->setEnabled(false);
+    REQUIRE(T.levelEnd[static_cast<size_t>(LogLevel::ERR)] == 1);
+    logger.log(LogLevel::ERR, &T, "B off");
+    REQUIRE(b == 0);
+    REQUIRE(c == 1);
+
+    mgr.handlerAt(0)->setEnabled(true);
+    REQUIRE(mgr.setHandlerGroups("C", handlerGroup(2)));
+    REQUIRE(T.dispatchGroups == handlerGroup(2));
+    mgr.disableGroups(handlerGroup(2));
+    logger.log(LogLevel::ERR, &T, "C grouped off");
+    REQUIRE(b == 1);
+    REQUIRE(c == 1);
+    mgr.enableGroups(handlerGroup(2));
+
+    RoutingTransaction tx(mgr);
+    tx.setLevel("B", LogLevel::TRACE);
+    REQUIRE(tx.commit());
+    REQUIRE(T.levelEnd[static_cast<size_t>(LogLevel::TRACE)] == 1);
+    REQUIRE(hot.contexts[0] == &b);
+    logger.log(LogLevel::DEBUG, &T, "only B");
+    REQUIRE(b == 2);
+    REQUIRE(c == 1);
+}
@@ -0,0 +1,118 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Deterministic clock: handlers advance it to simulate their own cost
+static uint64_t fakeClock = 0;
+#define LOGANYWHERE_LATENCY_NOW() (fakeClock)
+#define LOGANYWHERE_ENABLE_HANDLER_LATENCY 1
+
+#include "../include/LogAnywhere.h"
+
+using namespace LogAnywhere;
+
+// Handler that "takes" as many ns as its context says
+static void costlyHandler(const LogMessage &, void *ctx)
+{
+    fakeClock += *static_cast<uint64_t *>(ctx);
+}
+
+// Tests LatencyHistogram on its own:
+// 1) every value lands in a bucket whose upper edge is within the precision bound
+// 2) percentiles, max, mean and count on a known distribution
+// 3) concurrent recording loses no samples
+// 4) reset clears everything
+TEST_CASE("LatencyHistogram buckets and percentiles", "[LatencyHistogram]")
+{
+    SECTION("bucket precision")
+    {
+        for (uint64_t v = 0; v < (uint64_t(1) << 20); v = v * 3 / 2 + 1)
+        {
+            size_t idx = LatencyHistogram::bucketIndex(v);
+            uint64_t top = LatencyHistogram::bucketUpperBound(idx);
+            REQUIRE(top >= v);
+            REQUIRE(top - v <= v / LatencyHistogram::SUB_BUCKETS);
+            if (idx > 0)
+                REQUIRE(LatencyHistogram::bucketUpperBound(idx - 1) < v);
+        }
+        REQUIRE(LatencyHistogram::bucketIndex(UINT64_MAX) == LatencyHistogram::BUCKET_COUNT - 1);
+    }
+
+    SECTION("uniform distribution")
+    {
+        LatencyHistogram h;
+        REQUIRE(h.p50() == 0);
+        for (uint64_t v = 1; v <= 1000; ++v)
+            h.record(v);
+
+        REQUIRE(h.count() == 1000);
+        REQUIRE(h.max() == 1000);
+        REQUIRE(h.mean() == 500);
+        REQUIRE(h.p50() >= 500);
+        REQUIRE(h.p50() <= 500 + 500 / 8);
+        REQUIRE(h.p99() >= 990);
+        REQUIRE(h.p999() == 1000);
+        REQUIRE(h.valueAtPercentile(0) == 1);
+    }
+
+    SECTION("concurrent writers")
+    {
+        LatencyHistogram h;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&h, t]
+                                 { for (int i = 0; i < 10000; ++i) h.record(static_cast<uint64_t>(t * 100 + i % 7)); });
+        for (auto &th : threads)
+            th.join();
+        REQUIRE(h.count() == 40000);
+        REQUIRE(h.max() == 306);
+    }
+
+    SECTION("reset")
+    {
+        LatencyHistogram h;
+        h.record(42);
+        h.reset();
+        REQUIRE(h.count() == 0);
+        REQUIRE(h.max() == 0);
+        REQUIRE(h.p99() == 0);
+    }
+}
+
+// Tests Logger instrumentation:
+// 1) each handler's histogram reflects only its own cost
+// 2) skipped handlers record nothing
+// 3) histograms survive registry compaction after a delete
+TEST_CASE("Logger records per-handler latency", "[LatencyHistogram][Logger]")
+{
+    Tag NET("NET");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&NET};
+
+    uint64_t slowCost = 5000, fastCost = 10, idleCost = 1;
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, costlyHandler, &slowCost, tags, 1, "slow"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, costlyHandler, &fastCost, tags, 1, "fast"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::ERR, costlyHandler, &idleCost, tags, 1, "errors"));
+
+    for (int i = 0; i < 100; ++i)
+        logger.log(LogLevel::INFO, &NET, "tick");
+
+    const LatencyHistogram *slow = mgr.handlerLatency(1);
+    const LatencyHistogram *fast = mgr.handlerLatency(2);
+    REQUIRE(slow);
+    REQUIRE(fast);
+    REQUIRE(slow->count() == 100);
+    REQUIRE(slow->max() == 5000);
+    REQUIRE(slow->p99() == 5000);
+    REQUIRE(fast->p50() == 10);
+    REQUIRE(mgr.handlerLatency(3)->count() == 0);
+    REQUIRE(mgr.handlerLatency(99) == nullptr);
+
+    REQUIRE(mgr.deleteHandlerByName("slow"));
+    REQUIRE(mgr.handlerLatency(2)->count() == 100);
+    REQUIRE(mgr.handlerLatency(2)->max() == 10);
+}
@@ -4,6 +4,10 @@
 
 #include "../include/LogMessage.h"
 #include "../include/LogLevel.h"
+#include "../include/LogAnywhere.h"
+#include "../include/MessageRing.h"
+
+#include <string>
 
 using namespace LogAnywhere;
 
@@ -19,3 +23,36 @@ TEST_CASE("LogMessage stores its values correctly", "[LogMessage]") {
     REQUIRE(std::string(msg.message) == "This is a test log");
     REQUIRE(msg.timestamp == 123456);
 }
+
+// Tests the dense tag ID:
+// 1) Logger stamps Tag::id next to the name
+// 2) tagName() maps the ID back while the Tag lives
+// 3) an async ring keeps only the ID and still hands out the name
+TEST_CASE("LogMessage carries the Tag's dense ID", "[LogMessage][TagRegistry]") {
+    REQUIRE(LogMessage(LogLevel::INFO, "RAW", "no tag").tagId == 0);
+
+    Tag NET("NET");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    LogMessage seen{};
+    std::string seenName;
+    const Tag *tags[] = {&NET};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, [](const LogMessage &m, void *ctx) {
+        *static_cast<LogMessage *>(ctx) = m;
+    }, &seen, tags, 1));
+
+    logger.log(LogLevel::WARN, &NET, "up", 9);
+    REQUIRE(NET.id != 0);
+    REQUIRE(seen.tagId == NET.id);
+    REQUIRE(std::string(tagName(seen.tagId)) == "NET");
+    REQUIRE(tagName(0) == nullptr);
+
+    static MessageRing<4, 16> ring;
+    std::string text(14, 'x');  // fits only because the name is not stored
+    REQUIRE(ring.push(LogMessage(LogLevel::INFO, NET.name, text.c_str(), 1, NET.id)));
+    REQUIRE(ring.pop([](const LogMessage &m, void *ctx) {
+        auto *out = static_cast<std::string *>(ctx);
+        *out = std::string(m.tag) + "|" + m.message + "|" + std::to_string(m.tagId);
+    }, &seenName));
+    REQUIRE(seenName == "NET|" + text + "|" + std::to_string(NET.id));
+}
@@ -0,0 +1,107 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#define LOGANYWHERE_ENABLE_ORIGIN 1
+#include "../include/LogAnywhere.h"
+#include "../include/PersistentRing.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace LogAnywhere;
+
+struct Origin
+{
+    uint32_t threadId = 0;
+    uint32_t cpuId = UNKNOWN_CPU;
+};
+
+static void originHandler(const LogMessage &msg, void *ctx)
+{
+    auto *o = static_cast<Origin *>(ctx);
+    o->threadId = msg.threadId;
+    o->cpuId = msg.cpuId;
+}
+
+// Tests that messages carry the emitting thread and CPU:
+// 1) threadId is the OS thread ID, different on another thread
+// 2) cpuId names an online CPU
+TEST_CASE("LogMessage records thread and CPU", "[MessageOrigin]")
+{
+    Tag APP("APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    Origin origin;
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, originHandler, &origin, tags, 1));
+
+    logger.log(LogLevel::INFO, &APP, "main");
+    REQUIRE(origin.threadId == static_cast<uint32_t>(syscall(SYS_gettid)));
+    REQUIRE(origin.cpuId != UNKNOWN_CPU);
+    REQUIRE(origin.cpuId < static_cast<uint32_t>(sysconf(_SC_NPROCESSORS_CONF)));
+
+    const uint32_t mainThread = origin.threadId;
+    uint32_t workerThread = 0;
+    std::thread([&]
+                {
+                    workerThread = static_cast<uint32_t>(syscall(SYS_gettid));
+                    logger.log(LogLevel::INFO, &APP, "worker"); })
+        .join();
+    REQUIRE(origin.threadId == workerThread);
+    REQUIRE(origin.threadId != mainThread);
+}
+
+// Tests that currentCpu() agrees with sched_getcpu() (retried, since the
+// thread may migrate between the two reads)
+TEST_CASE("currentCpu matches sched_getcpu", "[MessageOrigin]")
+{
+    bool matched = false;
+    for (int i = 0; i < 100 && !matched; ++i)
+        matched = currentCpu() == static_cast<uint32_t>(sched_getcpu());
+    REQUIRE(matched);
+}
+
+// Tests the PersistentRing record format:
+// 1) origin fields round-trip through appendMessage()/decodeMessage()
+// 2) records without origin (older writers) still decode
+TEST_CASE("PersistentRing stores the origin", "[MessageOrigin]")
+{
+    std::string path = "/tmp/loganywhere_origin_" + std::to_string(getpid()) + ".ring";
+    std::remove(path.c_str());
+    PersistentRing ring;
+    REQUIRE(ring.open(path.c_str(), 8));
+
+    LogMessage msg(LogLevel::WARN, "NET", "link down", 99);
+    msg.threadId = 1234;
+    msg.cpuId = 3;
+    REQUIRE(ring.appendMessage(msg) != 0);
+
+    uint8_t buf[PersistentRing::DEFAULT_SLOT_SIZE];
+    size_t len = 0;
+    REQUIRE(ring.read(ring.lastId(), buf, sizeof(buf), len));
+    PersistentLogRecord rec;
+    REQUIRE(PersistentRing::decodeMessage(buf, len, rec));
+    REQUIRE(rec.level == LogLevel::WARN);
+    REQUIRE(rec.timestamp == 99);
+    REQUIRE(rec.threadId == 1234);
+    REQUIRE(rec.cpuId == 3);
+    REQUIRE(std::string(rec.tag, rec.tagLen) == "NET");
+    REQUIRE(std::string(rec.message, rec.messageLen) == "link down");
+
+    // u64 ts | u8 level | u8 tagLen | tag | message, as written without origin
+    const uint8_t legacy[] = {7, 0, 0, 0, 0, 0, 0, 0, static_cast<uint8_t>(LogLevel::ERR), 2, 'D', 'B', 'o', 'k'};
+    REQUIRE(PersistentRing::decodeMessage(legacy, sizeof(legacy), rec));
+    REQUIRE(rec.level == LogLevel::ERR);
+    REQUIRE(rec.timestamp == 7);
+    REQUIRE(rec.threadId == 0);
+    REQUIRE(rec.cpuId == UNKNOWN_CPU);
+    REQUIRE(std::string(rec.tag, rec.tagLen) == "DB");
+    REQUIRE(std::string(rec.message, rec.messageLen) == "ok");
+
+    ring.close();
+    std::remove(path.c_str());
+}
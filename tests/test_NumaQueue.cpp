@@ -0,0 +1,125 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+#include "../include/NumaQueue.h"
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+
+static void collectCpu(void *ctx, size_t cpu, size_t node)
+{
+    static_cast<std::vector<size_t> *>(ctx)->push_back(cpu * 100 + node);
+}
+
+// Tests topology discovery:
+// 1) sysfs CPU lists with ranges and single CPUs parse correctly
+// 2) the detected host topology places the current CPU on a valid node
+// 3) assign() builds emulated layouts and moves CPUs between nodes
+TEST_CASE("NumaTopology parses and maps CPUs", "[NumaQueue]")
+{
+    std::vector<size_t> cpus;
+    REQUIRE(NumaTopology::parseCpuList("0-2,5,7-8\n", collectCpu, &cpus, 1));
+    REQUIRE(cpus == std::vector<size_t>{1, 101, 201, 501, 701, 801});
+    cpus.clear();
+    REQUIRE_FALSE(NumaTopology::parseCpuList("\n", collectCpu, &cpus, 0));
+
+    NumaTopology host = NumaTopology::detect();
+    REQUIRE(host.nodeCount() >= 1);
+    REQUIRE(host.nodeOf(currentCpu()) < host.nodeCount());
+    REQUIRE(CPU_ISSET(currentCpu(), &host.cpusOf(host.nodeOf(currentCpu()))));
+
+    NumaTopology emulated;
+    REQUIRE(emulated.assign(0, 0));
+    REQUIRE(emulated.assign(1, 1));
+    REQUIRE(emulated.assign(2, 1));
+    REQUIRE(emulated.nodeCount() == 2);
+    REQUIRE(emulated.nodeOf(2) == 1);
+    REQUIRE(emulated.assign(2, 0));
+    REQUIRE(emulated.nodeOf(2) == 0);
+    REQUIRE_FALSE(CPU_ISSET(2, &emulated.cpusOf(1)));
+    REQUIRE(emulated.nodeOf(99) == 0);
+    REQUIRE_FALSE(emulated.assign(0, NumaTopology::MAX_NODES));
+}
+
+struct Sink
+{
+    std::mutex lock;
+    std::vector<std::string> messages;
+    std::vector<uint64_t> timestamps;
+    std::set<std::thread::id> threadsByNode[2];
+    std::set<std::thread::id> threads;
+};
+
+static void recordNode(const LogMessage &msg, void *ctx)
+{
+    auto *s = static_cast<Sink *>(ctx);
+    std::lock_guard<std::mutex> guard(s->lock);
+    s->messages.emplace_back(msg.message);
+    s->timestamps.push_back(msg.timestamp);
+    s->threads.insert(std::this_thread::get_id());
+    s->threadsByNode[msg.tag[0] - '0'].insert(std::this_thread::get_id());
+}
+
+// Tests per-node consumers on an emulated two-node host:
+// 1) every record is delivered after stop()
+// 2) each node's records are drained by that node's own consumer
+TEST_CASE("NumaQueue runs one consumer per node", "[NumaQueue]")
+{
+    NumaTopology topo;
+    topo.assign(0, 0);
+    topo.assign(1, 1);
+    static NumaQueue queue;
+    Sink sink;
+    REQUIRE(queue.start(topo, recordNode, &sink));
+    REQUIRE(queue.nodes() == 2);
+    REQUIRE_FALSE(queue.start(topo, recordNode, &sink));
+
+    for (int i = 0; i < 40; ++i)
+        REQUIRE(queue.push(LogMessage(LogLevel::INFO, i % 2 ? "1" : "0", "x", i + 1), i % 2));
+    REQUIRE_FALSE(queue.push(LogMessage(LogLevel::INFO, "0", "x", 1), 2));
+    queue.stop();
+
+    REQUIRE(sink.messages.size() == 40);
+    REQUIRE(queue.dropped() == 0);
+    REQUIRE(sink.threadsByNode[0].size() == 1);
+    REQUIRE(sink.threadsByNode[1].size() == 1);
+    REQUIRE(*sink.threadsByNode[0].begin() != *sink.threadsByNode[1].begin());
+}
+
+// Tests the merged mode and the Logger adapter:
+// 1) one consumer delivers everything, in timestamp order
+// 2) logHandler() routes through the calling CPU's node
+TEST_CASE("NumaQueue merges nodes into one ordered stream", "[NumaQueue]")
+{
+    NumaTopology topo;
+    topo.assign(0, 0);
+    topo.assign(1, 1);
+    static NumaQueue queue;
+    Sink sink;
+    REQUIRE(queue.start(topo, recordNode, &sink, true));
+
+    for (int i = 0; i < 40; ++i)
+        REQUIRE(queue.push(LogMessage(LogLevel::INFO, i % 2 ? "1" : "0", "x", i + 1), i % 2));
+
+    Tag APP("0APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::INFO, NumaQueue::logHandler, &queue, tags, 1));
+    logger.log(LogLevel::WARN, &APP, "adapter", 1000);
+    queue.stop();
+
+    REQUIRE(sink.messages.size() == 41);
+    REQUIRE(sink.messages.back() == "adapter");
+    REQUIRE(sink.threads.size() == 1);
+    bool ascending = true;
+    for (size_t i = 1; i < sink.timestamps.size(); ++i)
+        ascending = ascending && sink.timestamps[i] > sink.timestamps[i - 1];
+    REQUIRE(ascending);
+}
@@ -0,0 +1,148 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+#include "../include/PerCpuRing.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+
+struct Drained
+{
+    std::vector<LogLevel> levels;
+    std::vector<std::string> tags;
+    std::vector<std::string> messages;
+    std::vector<uint64_t> timestamps;
+};
+
+static void collect(const LogMessage &msg, void *ctx)
+{
+    auto *d = static_cast<Drained *>(ctx);
+    d->levels.push_back(msg.level);
+    d->tags.emplace_back(msg.tag);
+    d->messages.emplace_back(msg.message);
+    d->timestamps.push_back(msg.timestamp);
+}
+
+// Tests the basic round trip:
+// 1) push() deep-copies the strings, drain() restores every field
+// 2) over-long text is truncated to the slot
+// 3) logHandler() enqueues from a normal Logger dispatch
+TEST_CASE("PerCpuRing copies messages and drains them", "[PerCpuRing]")
+{
+    static PerCpuRing queue;
+    char text[] = "first";
+    REQUIRE(queue.push(LogMessage(LogLevel::WARN, "NET", text, 5)));
+    text[0] = 'X'; // the queued copy is unaffected
+    std::string longText(PerCpuRing::SLOT_TEXT * 2, 'm');
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "NET", longText.c_str(), 6)));
+
+    Tag APP("APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::DEBUG, PerCpuRing::logHandler, &queue, tags, 1));
+    logger.log(LogLevel::ERR, &APP, "via handler", 7);
+
+    Drained d;
+    REQUIRE(queue.drain(collect, &d) == 3);
+    REQUIRE(d.levels[0] == LogLevel::WARN);
+    REQUIRE(d.tags[0] == "NET");
+    REQUIRE(d.messages[0] == "first");
+    REQUIRE(d.timestamps[0] == 5);
+    REQUIRE(d.messages[1] == std::string(PerCpuRing::SLOT_TEXT - 5, 'm'));
+    REQUIRE(d.tags[2] == "APP");
+    REQUIRE(d.messages[2] == "via handler");
+    REQUIRE(queue.drain(collect, &d) == 0);
+}
+
+// Tests the consumer's merge and the full-ring policy:
+// 1) records from different rings come out in timestamp order
+// 2) a full ring drops and counts new records; other rings are unaffected
+// 3) maxRecords bounds one drain() call
+TEST_CASE("PerCpuRing merges rings and drops when full", "[PerCpuRing]")
+{
+    static PerCpuRing queue;
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "A", "a1", 10), 0));
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "B", "b1", 11), 1));
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "A", "a2", 12), 0));
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "B", "b2", 13), 1));
+
+    Drained d;
+    REQUIRE(queue.drain(collect, &d, 3) == 3);
+    REQUIRE(queue.drain(collect, &d) == 1);
+    REQUIRE(d.messages == std::vector<std::string>{"a1", "b1", "a2", "b2"});
+
+    for (size_t i = 0; i < PerCpuRing::SLOTS; ++i)
+        REQUIRE(queue.push(LogMessage(LogLevel::INFO, "A", "fill", 100 + i), 0));
+    REQUIRE_FALSE(queue.push(LogMessage(LogLevel::INFO, "A", "over", 999), 0));
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "B", "other", 1000), 1));
+    REQUIRE(queue.dropped() == 1);
+    REQUIRE(queue.dropped(0) == 1);
+
+    d = Drained{};
+    REQUIRE(queue.drain(collect, &d) == PerCpuRing::SLOTS + 1);
+    REQUIRE(d.messages.back() == "other");
+    REQUIRE(queue.push(LogMessage(LogLevel::INFO, "A", "again", 2000), 0));
+}
+
+struct Tally
+{
+    std::vector<int> seen;
+};
+
+static void tally(const LogMessage &msg, void *ctx)
+{
+    auto *t = static_cast<Tally *>(ctx);
+    const int thread = msg.tag[0] - 'a';
+    const int index = std::stoi(msg.message);
+    ++t->seen[thread * 100000 + index];
+}
+
+// Tests concurrent producers against a running consumer:
+// every accepted record is delivered exactly once
+TEST_CASE("PerCpuRing under concurrent producers", "[PerCpuRing]")
+{
+    static PerCpuRing queue;
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 5000;
+    Tally t;
+    t.seen.assign(THREADS * 100000, 0);
+
+    std::atomic<int> producersLeft{THREADS};
+    std::atomic<uint64_t> accepted{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < THREADS; ++p)
+    {
+        producers.emplace_back([p, &accepted, &producersLeft]
+                               {
+                                   const char tag[2] = {static_cast<char>('a' + p), '\0'};
+                                   for (int i = 0; i < PER_THREAD; ++i)
+                                   {
+                                       const std::string text = std::to_string(i);
+                                       if (queue.push(LogMessage(LogLevel::INFO, tag, text.c_str(), i + 1)))
+                                           accepted.fetch_add(1);
+                                       else
+                                           std::this_thread::yield();
+                                   }
+                                   producersLeft.fetch_sub(1); });
+    }
+
+    size_t delivered = 0;
+    while (producersLeft.load() > 0)
+        delivered += queue.drain(tally, &t);
+    delivered += queue.drain(tally, &t);
+    for (auto &th : producers)
+        th.join();
+
+    REQUIRE(delivered == accepted.load());
+    REQUIRE(accepted.load() + queue.dropped() == uint64_t(THREADS) * PER_THREAD);
+    bool exactlyOnce = true;
+    for (int v : t.seen)
+        exactlyOnce = exactlyOnce && v <= 1;
+    REQUIRE(exactlyOnce);
+}
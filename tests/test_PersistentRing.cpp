@@ -0,0 +1,252 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+#include "../include/PersistentRing.h"
+
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+using namespace LogAnywhere;
+
+// Builds a per-process scratch path so parallel test runs do not collide.
+static std::string ringPath(const char *name)
+{
+    return "/tmp/loganywhere_" + std::string(name) + "_" + std::to_string(getpid()) + ".ring";
+}
+
+// Appends "rec-<n>" strings and returns the last ID.
+static uint64_t appendRecords(PersistentRing &ring, int from, int to)
+{
+    uint64_t id = 0;
+    for (int i = from; i <= to; ++i)
+    {
+        std::string s = "rec-" + std::to_string(i);
+        id = ring.append(s.data(), s.size());
+    }
+    return id;
+}
+
+// Reads a record back as a string ("" if unreadable).
+static std::string readRecord(const PersistentRing &ring, uint64_t id)
+{
+    char buf[256];
+    size_t len = 0;
+    if (!ring.read(id, buf, sizeof(buf), len))
+        return "";
+    return std::string(buf, len);
+}
+
+// Flips one byte at a file offset, simulating a torn write.
+static void corruptByte(const std::string &path, long offset)
+{
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekg(offset);
+    char c = 0;
+    f.read(&c, 1);
+    c ^= 0x5A;
+    f.seekp(offset);
+    f.write(&c, 1);
+}
+
+// Tests PersistentRing basic operation:
+// 1) records get monotonic IDs starting at 1 and read back intact
+// 2) reopening recovers the tail and continues the ID sequence
+// 3) wrap-around keeps only the newest slotCount records
+// 4) geometry mismatches and oversized payloads are refused
+// 5) a right-sized file with an unfinished header is initialized again
+TEST_CASE("PersistentRing appends, reopens and wraps", "[PersistentRing]")
+{
+    std::string path = ringPath("basic");
+    std::remove(path.c_str());
+
+    SECTION("IDs are monotonic and payloads round-trip")
+    {
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), 16));
+        REQUIRE(ring.lastId() == 0);
+        REQUIRE(ring.firstId() > ring.lastId());
+
+        REQUIRE(appendRecords(ring, 1, 5) == 5);
+        REQUIRE(ring.firstId() == 1);
+        REQUIRE(readRecord(ring, 3) == "rec-3");
+        REQUIRE(readRecord(ring, 6) == "");
+    }
+
+    SECTION("reopen recovers the tail")
+    {
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), 16));
+            appendRecords(ring, 1, 11);
+        }
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), 16));
+        REQUIRE(ring.lastId() == 11);
+        REQUIRE(ring.firstId() == 1);
+        REQUIRE(ring.append("next", 4) == 12);
+        REQUIRE(readRecord(ring, 12) == "next");
+    }
+
+    SECTION("wrap-around keeps the newest records across reopen")
+    {
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), 8));
+            REQUIRE(appendRecords(ring, 1, 21) == 21);
+            REQUIRE(ring.firstId() == 14);
+        }
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), 8));
+        REQUIRE(ring.lastId() == 21);
+        REQUIRE(ring.firstId() == 14);
+        REQUIRE(readRecord(ring, 13) == "");
+        REQUIRE(readRecord(ring, 14) == "rec-14");
+        REQUIRE(readRecord(ring, 21) == "rec-21");
+    }
+
+    SECTION("refuses mismatched geometry and oversized payloads")
+    {
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), 8, 64));
+            char big[64] = {};
+            REQUIRE(ring.append(big, sizeof(big)) == 0);
+            REQUIRE(ring.append(big, ring.maxPayload()) == 1);
+        }
+        PersistentRing ring;
+        REQUIRE_FALSE(ring.open(path.c_str(), 16, 64));
+        REQUIRE_FALSE(ring.isOpen());
+    }
+
+    SECTION("re-initializes a file whose header was never completed")
+    {
+        // Crash between ftruncate and the magic store: right size, no magic
+        PersistentRingHeader partial = {};
+        partial.slotCount = 8;
+        partial.slotSize = 64;
+        std::string image(sizeof(PersistentRingHeader) + 8 * 64, '\0');
+        std::memcpy(&image[0], &partial, sizeof(partial));
+        std::ofstream(path, std::ios::binary) << image;
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), 8, 64));
+            REQUIRE(appendRecords(ring, 1, 3) == 3);
+        }
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), 8, 64));
+        REQUIRE(readRecord(ring, 3) == "rec-3");
+
+        // A foreign file of the same size is still refused
+        ring.close();
+        std::ofstream(path, std::ios::binary) << std::string(image.size(), 'x');
+        REQUIRE_FALSE(ring.open(path.c_str(), 8, 64));
+    }
+
+    std::remove(path.c_str());
+}
+
+// Tests crash recovery and shipper resume:
+// 1) a torn newest record is discarded and its ID reused
+// 2) a torn slot after wrap-around only loses that record
+// 3) the acknowledged ID persists and drives nextUnacknowledged()
+TEST_CASE("PersistentRing recovers from torn writes", "[PersistentRing][recovery]")
+{
+    std::string path = ringPath("torn");
+    std::remove(path.c_str());
+    const uint32_t slots = 8, slotSize = 64;
+    auto payloadOffset = [&](uint64_t id)
+    {
+        return static_cast<long>(sizeof(PersistentRingHeader) + ((id - 1) % slots) * slotSize +
+                                 sizeof(PersistentSlotHeader));
+    };
+
+    SECTION("torn newest record is dropped")
+    {
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), slots, slotSize));
+            appendRecords(ring, 1, 5);
+        }
+        corruptByte(path, payloadOffset(5));
+
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), slots, slotSize));
+        REQUIRE(ring.lastId() == 4);
+        REQUIRE(ring.append("again", 5) == 5);
+        REQUIRE(readRecord(ring, 5) == "again");
+    }
+
+    SECTION("torn slot after wrap-around")
+    {
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), slots, slotSize));
+            appendRecords(ring, 1, 12);
+        }
+        corruptByte(path, payloadOffset(12));
+
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), slots, slotSize));
+        REQUIRE(ring.lastId() == 11);
+        REQUIRE(ring.firstId() == 5);
+        REQUIRE(readRecord(ring, 5) == "rec-5");
+    }
+
+    SECTION("acknowledged ID survives restart")
+    {
+        {
+            PersistentRing ring;
+            REQUIRE(ring.open(path.c_str(), slots, slotSize));
+            appendRecords(ring, 1, 6);
+            REQUIRE(ring.nextUnacknowledged() == 1);
+            ring.acknowledge(4);
+            ring.acknowledge(2); // older acks are ignored
+            REQUIRE(ring.sync());
+        }
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), slots, slotSize));
+        REQUIRE(ring.acknowledgedId() == 4);
+        REQUIRE(ring.nextUnacknowledged() == 5);
+
+        appendRecords(ring, 7, 20);
+        REQUIRE(ring.nextUnacknowledged() == ring.firstId());
+    }
+
+    std::remove(path.c_str());
+}
+
+// Verifies PersistentRing::logHandler persists dispatched LogMessages
+TEST_CASE("PersistentRing works as a log handler", "[PersistentRing][handler]")
+{
+    std::string path = ringPath("handler");
+    std::remove(path.c_str());
+
+    PersistentRing ring;
+    REQUIRE(ring.open(path.c_str(), 32));
+
+    Tag OTA("OTA");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&OTA};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::INFO, PersistentRing::logHandler, &ring, tags, 1, "ring"));
+
+    logger.log(LogLevel::WARN, &OTA, "image verified", 777);
+
+    uint8_t buf[PersistentRing::DEFAULT_SLOT_SIZE];
+    size_t len = 0;
+    REQUIRE(ring.read(ring.lastId(), buf, sizeof(buf), len));
+
+    PersistentLogRecord rec;
+    REQUIRE(PersistentRing::decodeMessage(buf, len, rec));
+    REQUIRE(rec.level == LogLevel::WARN);
+    REQUIRE(rec.timestamp == 777);
+    REQUIRE(std::string(rec.tag, rec.tagLen) == "OTA");
+    REQUIRE(std::string(rec.message, rec.messageLen) == "image verified");
+
+    ring.close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,184 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#define LOGANYWHERE_ENABLE_STATS 1
+#define LOGANYWHERE_ENABLE_GROWABLE 1
+#include "../include/LogAnywhere.h"
+
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+
+static void countingHandler(const LogMessage &, void *ctx)
+{
+    ++*static_cast<int *>(ctx);
+}
+
+// Finds a handler's row in a snapshot by ID.
+static const HandlerStats *rowFor(const RoutingStatsSnapshot &snap, uint16_t id)
+{
+    for (size_t i = 0; i < snap.handlerCount; ++i)
+        if (snap.handlers[i].id == id)
+            return &snap.handlers[i];
+    return nullptr;
+}
+
+// Tests routing statistics:
+// 1) logged counts by level, globally and per tag
+// 2) delivered / dropped-by-level / dropped-by-disabled per handler and in total
+// 3) subscriptions refused by a full tag are reported
+// 4) per-handler counters follow handlers across compaction; totals survive deletes
+// 5) resetStats zeroes the manager's counters
+TEST_CASE("HandlerManager::snapshotStats reports routing decisions", "[RoutingStats]")
+{
+    Tag NET("NET"), DB("DB");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *net[] = {&NET};
+    const Tag *both[] = {&NET, &DB};
+    int calls = 0;
+
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &calls, net, 1, "all"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::WARN, countingHandler, &calls, both, 2, "warn"));
+
+    logger.log(LogLevel::DEBUG, &NET, "a");
+    logger.log(LogLevel::WARN, &NET, "b");
+    logger.log(LogLevel::ERR, &DB, "c");
+
+    SECTION("logged and delivered counts")
+    {
+        auto snap = mgr.snapshotStats();
+        REQUIRE(snap.logged[static_cast<size_t>(LogLevel::DEBUG)] == 1);
+        REQUIRE(snap.logged[static_cast<size_t>(LogLevel::WARN)] == 1);
+        REQUIRE(snap.logged[static_cast<size_t>(LogLevel::ERR)] == 1);
+        REQUIRE(snap.delivered == 4);
+        REQUIRE(snap.droppedByLevel == 1);
+        REQUIRE(snap.droppedByDisabled == 0);
+
+        REQUIRE(snap.handlerCount == 2);
+        REQUIRE(rowFor(snap, 1)->delivered == 2);
+        REQUIRE(rowFor(snap, 2)->delivered == 2);
+        REQUIRE(rowFor(snap, 2)->droppedByLevel == 1);
+        REQUIRE(std::string(rowFor(snap, 2)->name) == "warn");
+
+        auto netStats = mgr.snapshotStats(&NET);
+        REQUIRE(netStats.total == 2);
+        REQUIRE(netStats.logged[static_cast<size_t>(LogLevel::DEBUG)] == 1);
+        REQUIRE(mgr.snapshotStats(&DB).total == 1);
+    }
+
+    SECTION("disabled handlers are counted")
+    {
+        size_t count = 0;
+        auto *entries = const_cast<HandlerEntry *>(mgr.listHandlers(count));
+        entries[0].setEnabled(false);
+        logger.log(LogLevel::INFO, &NET, "d");
+
+        auto snap = mgr.snapshotStats();
+        REQUIRE(snap.droppedByDisabled == 1);
+        REQUIRE(rowFor(snap, 1)->droppedByDisabled == 1);
+        REQUIRE(rowFor(snap, 2)->droppedByLevel == 2);
+    }
+
+    SECTION("full tags report refused subscriptions")
+    {
+        Tag FULL("FULL");
+        FULL.handlerCount = MAX_TAG_SUBSCRIPTIONS;
+        const Tag *tags[] = {&FULL, &DB};
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::INFO, countingHandler, &calls, tags, 2, "late"));
+
+        auto snap = mgr.snapshotStats();
+        REQUIRE(snap.droppedSubscriptions == 1);
+        REQUIRE(rowFor(snap, 3)->droppedSubscriptions == 1);
+        REQUIRE(rowFor(snap, 1)->droppedSubscriptions == 0);
+    }
+
+    SECTION("deletes keep counters with the right handler")
+    {
+        REQUIRE(mgr.deleteHandlerByName("all"));
+        auto snap = mgr.snapshotStats();
+        REQUIRE(snap.handlerCount == 1);
+        REQUIRE(rowFor(snap, 2)->delivered == 2);
+        REQUIRE(rowFor(snap, 2)->droppedByLevel == 1);
+        REQUIRE(snap.delivered == 4);
+
+        const Tag *db[] = {&DB};
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &calls, db, 1, "fresh"));
+        REQUIRE(rowFor(mgr.snapshotStats(), 3)->delivered == 0);
+    }
+
+    SECTION("reset")
+    {
+        mgr.resetStats();
+        auto snap = mgr.snapshotStats();
+        REQUIRE(snap.delivered == 0);
+        REQUIRE(snap.logged[static_cast<size_t>(LogLevel::WARN)] == 0);
+        REQUIRE(rowFor(snap, 1)->delivered == 0);
+    }
+
+    REQUIRE(mgr.snapshotStats().handlerCount >= 1);
+}
+
+// Verifies per-thread shards aggregate exactly under concurrent logging
+TEST_CASE("Routing statistics aggregate across threads", "[RoutingStats][threads]")
+{
+    Tag BUS("BUS");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&BUS};
+    std::atomic<int> calls{0};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::INFO, [](const LogMessage &, void *ctx)
+                                       { static_cast<std::atomic<int> *>(ctx)->fetch_add(1); },
+                                       &calls, tags, 1, "bus"));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&]
+                             {
+            for (int i = 0; i < 1000; ++i)
+                logger.log(i % 2 ? LogLevel::INFO : LogLevel::DEBUG, &BUS, "x", 1); });
+    for (auto &th : threads)
+        th.join();
+
+    auto snap = mgr.snapshotStats();
+    REQUIRE(snap.logged[static_cast<size_t>(LogLevel::INFO)] == 2000);
+    REQUIRE(snap.logged[static_cast<size_t>(LogLevel::DEBUG)] == 2000);
+    REQUIRE(snap.delivered == 2000);
+    REQUIRE(snap.droppedByLevel == 2000);
+    REQUIRE(calls.load() == 2000);
+    REQUIRE(mgr.snapshotStats(&BUS).total == 4000);
+}
+
+// Verifies every handler of a growable registry has its own counters,
+// including those beyond LOGANYWHERE_MAX_HANDLERS, and that they can be paged.
+TEST_CASE("Routing statistics cover growable registries", "[RoutingStats][GrowableRegistry]")
+{
+    alignas(std::max_align_t) static unsigned char buffer[256 * 1024];
+    ArenaResource arena(buffer, sizeof(buffer));
+    MemoryResource memory = arena.resource();
+    HandlerManager mgr(memory);
+    Logger logger(&mgr);
+    Tag WIDE("WIDE");
+    const Tag *tags[] = {&WIDE};
+    int calls = 0;
+
+    constexpr size_t N = LOGANYWHERE_MAX_HANDLERS * 5;
+    for (size_t i = 0; i < N; ++i)
+        REQUIRE(mgr.registerHandlerForTags(i % 2 ? LogLevel::ERR : LogLevel::TRACE, countingHandler, &calls, tags, 1));
+    logger.log(LogLevel::INFO, &WIDE, "w");
+
+    REQUIRE(mgr.snapshotStats().handlerCount == LOGANYWHERE_MAX_HANDLERS);
+    HandlerStats rows[N];
+    REQUIRE(mgr.snapshotHandlerStats(rows, N) == N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        REQUIRE(rows[i].id == i + 1);
+        REQUIRE(rows[i].delivered == (i % 2 ? 0u : 1u));
+        REQUIRE(rows[i].droppedByLevel == (i % 2 ? 1u : 0u));
+    }
+
+    HandlerStats tail[4];
+    REQUIRE(mgr.snapshotHandlerStats(tail, 4, N - 2) == 2);
+    REQUIRE(tail[1].id == N);
+}
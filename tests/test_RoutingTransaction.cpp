@@ -0,0 +1,107 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+#include "../include/RoutingTransaction.h"
+
+#include <string>
+
+using namespace LogAnywhere;
+
+static void countingHandler(const LogMessage &, void *ctx)
+{
+    ++*static_cast<int *>(ctx);
+}
+
+// Tests RoutingTransaction against a static HandlerManager:
+// 1) deletions, registrations and level changes are applied together
+// 2) survivors keep their Tag subscriptions after the one-pass compaction
+// 3) an invalid change or a capacity overflow leaves everything untouched
+// 4) freed slots are usable by registrations in the same transaction
+TEST_CASE("RoutingTransaction commits staged changes together", "[RoutingTransaction]")
+{
+    Tag NET("NET"), DB("DB");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *net[] = {&NET};
+    const Tag *both[] = {&NET, &DB};
+    int a = 0, b = 0, c = 0, d = 0;
+
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &a, net, 1, "a"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &b, both, 2, "b"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &c, both, 2, "c"));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &d, net, 1, "d"));
+
+    SECTION("everything is applied in one commit")
+    {
+        RoutingTransaction tx(mgr);
+        REQUIRE(tx.deleteHandler("a"));
+        REQUIRE(tx.deleteHandler(static_cast<uint16_t>(3)));
+        REQUIRE(tx.registerHandler(LogLevel::TRACE, countingHandler, &a, both, 2, "a2"));
+        REQUIRE(tx.setLevel("d", LogLevel::ERR));
+        REQUIRE(tx.setLevel("a2", LogLevel::WARN));
+        REQUIRE(tx.size() == 5);
+        REQUIRE(tx.commit());
+        REQUIRE(tx.size() == 0);
+
+        size_t count = 0;
+        const HandlerEntry *entries = mgr.listHandlers(count);
+        REQUIRE(count == 3);
+        REQUIRE(std::string(entries[0].name) == "b");
+        REQUIRE(std::string(entries[1].name) == "d");
+        REQUIRE(std::string(entries[2].name) == "a2");
+        REQUIRE(entries[1].level == LogLevel::ERR);
+        REQUIRE(entries[2].level == LogLevel::WARN);
+        REQUIRE(NET.handlerCount == 3);
+        REQUIRE(DB.handlerCount == 2);
+
+        logger.log(LogLevel::INFO, &NET, "info");
+        logger.log(LogLevel::ERR, &DB, "err");
+        REQUIRE(a == 1);
+        REQUIRE(b == 2);
+        REQUIRE(c == 0);
+        REQUIRE(d == 0);
+    }
+
+    SECTION("an unknown target rejects the whole transaction")
+    {
+        RoutingTransaction tx(mgr);
+        REQUIRE(tx.deleteHandler("b"));
+        REQUIRE(tx.registerHandler(LogLevel::TRACE, countingHandler, &a, net, 1, "new"));
+        REQUIRE(tx.setLevel("missing", LogLevel::ERR));
+        REQUIRE_FALSE(tx.commit());
+        REQUIRE(mgr.registeredCount() == 4);
+        REQUIRE(NET.handlerCount == 4);
+
+        tx.discard();
+        REQUIRE(tx.deleteHandler("b"));
+        REQUIRE(tx.setLevel("b", LogLevel::ERR)); // deleted in the same commit
+        REQUIRE_FALSE(tx.commit());
+        REQUIRE(mgr.registeredCount() == 4);
+    }
+
+    SECTION("registrations may use slots freed in the same commit")
+    {
+        RoutingTransaction tx(mgr);
+        for (size_t i = mgr.registeredCount(); i < LOGANYWHERE_MAX_HANDLERS; ++i)
+            REQUIRE(tx.registerHandler(LogLevel::TRACE, countingHandler, &a, net, 1));
+        REQUIRE(tx.registerHandler(LogLevel::TRACE, countingHandler, &a, net, 1));
+        REQUIRE_FALSE(tx.commit()); // one too many
+        REQUIRE(mgr.registeredCount() == 4);
+
+        REQUIRE(tx.deleteHandler("c"));
+        REQUIRE(tx.commit());
+        REQUIRE(mgr.registeredCount() == LOGANYWHERE_MAX_HANDLERS);
+        REQUIRE(DB.handlerCount == 1);
+        REQUIRE(NET.handlerCount == LOGANYWHERE_MAX_HANDLERS);
+    }
+
+    SECTION("the staging array is bounded")
+    {
+        RoutingTransaction tx(mgr);
+        for (size_t i = 0; i < RoutingTransaction::MAX_CHANGES; ++i)
+            REQUIRE(tx.setLevel("a", LogLevel::INFO));
+        REQUIRE_FALSE(tx.setLevel("a", LogLevel::INFO));
+        REQUIRE(tx.commit());
+    }
+}
@@ -0,0 +1,163 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#define LOGANYWHERE_SIGNAL_SLOTS 8
+#define LOGANYWHERE_SIGNAL_TEXT 16
+#define LOGANYWHERE_ENABLE_SIGNAL_LOG 1
+#include "../include/LogAnywhere.h"
+
+#include <atomic>
+#include <csignal>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+
+struct Drained
+{
+    std::vector<LogLevel> levels;
+    std::vector<std::string> tags;
+    std::vector<std::string> messages;
+    std::vector<uint64_t> timestamps;
+};
+
+static void collect(const LogMessage &msg, void *ctx)
+{
+    auto *d = static_cast<Drained *>(ctx);
+    d->levels.push_back(msg.level);
+    d->tags.emplace_back(msg.tag);
+    d->messages.emplace_back(msg.message);
+    d->timestamps.push_back(msg.timestamp);
+}
+
+// Tests the round trip through a Logger:
+// 1) log() only queues; handlers run when the ring is drained
+// 2) text is copied and truncated, the timestamp kept
+// 3) records come out in reservation order, maxRecords is honoured
+TEST_CASE("SignalRing defers dispatch to drain()", "[SignalRing]")
+{
+    static SignalRing ring;
+    Tag SIG("SIG");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    Drained d;
+    const Tag *tags[] = {&SIG};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::DEBUG, collect, &d, tags, 1));
+
+    char text[] = "first";
+    REQUIRE(ring.log(LogLevel::WARN, &SIG, text, 5));
+    text[0] = 'X'; // the queued copy is unaffected
+    REQUIRE(ring.log(LogLevel::ERR, &SIG, "a message longer than the slot", 6));
+    REQUIRE(ring.log(LogLevel::INFO, &SIG, "third", 7));
+    REQUIRE_FALSE(ring.log(LogLevel::INFO, nullptr, "no tag"));
+    REQUIRE(d.messages.empty());
+
+    REQUIRE(ring.drain(logger, 2) == 2);
+    REQUIRE(ring.drain(logger) == 1);
+    REQUIRE(ring.drain(logger) == 0);
+    REQUIRE(d.levels == std::vector<LogLevel>{LogLevel::WARN, LogLevel::ERR, LogLevel::INFO});
+    REQUIRE(d.tags[0] == "SIG");
+    REQUIRE(d.messages[0] == "first");
+    REQUIRE(d.messages[1] == std::string("a message longer than the slot", SignalRing::TEXT - 1));
+    REQUIRE(d.timestamps == std::vector<uint64_t>{5, 6, 7});
+}
+
+// Tests overflow: reservations that find their slot busy are dropped and
+// skipped, and the ring keeps working across many laps afterwards
+TEST_CASE("SignalRing drops on overflow and recovers", "[SignalRing]")
+{
+    static SignalRing ring;
+    Tag SIG("SIG");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    Drained d;
+    const Tag *tags[] = {&SIG};
+    mgr.registerHandlerForTags(LogLevel::DEBUG, collect, &d, tags, 1);
+
+    for (uint64_t i = 1; i <= SignalRing::SLOTS + 3; ++i)
+        ring.log(LogLevel::INFO, &SIG, "m", i);
+    REQUIRE(ring.dropped() == 3);
+    REQUIRE(ring.drain(logger) == SignalRing::SLOTS);
+    REQUIRE(d.timestamps.back() == SignalRing::SLOTS);
+
+    d.timestamps.clear();
+    for (uint64_t i = 1; i <= SignalRing::SLOTS * 10; ++i)
+    {
+        REQUIRE(ring.log(LogLevel::INFO, &SIG, "m", i));
+        if (i % 3 == 0)
+            ring.drain(logger);
+    }
+    ring.drain(logger);
+    REQUIRE(d.timestamps.size() == SignalRing::SLOTS * 10);
+    REQUIRE(d.timestamps.back() == SignalRing::SLOTS * 10);
+    REQUIRE(ring.dropped() == 3);
+}
+
+static Tag SIGNALS("SIGNALS");
+static volatile sig_atomic_t handled = 0;
+
+static void onSignal(int)
+{
+    logFromSignal(LogLevel::WARN, &SIGNALS, "caught SIGUSR1");
+    handled = 1;
+}
+
+// Tests the global API from a real signal handler: nothing is dispatched
+// inside the handler, dispatchSignalLogs() delivers it afterwards
+TEST_CASE("logFromSignal queues from a signal handler", "[SignalRing]")
+{
+    Drained d;
+    const Tag *tags[] = {&SIGNALS};
+    REQUIRE(registerHandler(LogLevel::INFO, collect, &d, tags, 1, "signals"));
+
+    auto previous = std::signal(SIGUSR1, onSignal);
+    std::raise(SIGUSR1);
+    std::signal(SIGUSR1, previous);
+    REQUIRE(handled == 1);
+    REQUIRE(d.messages.empty());
+
+    REQUIRE(dispatchSignalLogs() == 1);
+    REQUIRE(d.messages == std::vector<std::string>{"caught SIGUSR1"});
+    REQUIRE(d.levels[0] == LogLevel::WARN);
+    clearHandlers();
+}
+
+// Tests concurrent producers against a concurrent consumer: every record
+// is either delivered exactly once or counted as dropped
+TEST_CASE("SignalRing accounts for every record under contention", "[SignalRing]")
+{
+    static SignalRing ring;
+    Tag SIG("SIG");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    Drained d;
+    const Tag *tags[] = {&SIG};
+    mgr.registerHandlerForTags(LogLevel::DEBUG, collect, &d, tags, 1);
+
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 5000;
+    std::atomic<int> running{PRODUCERS};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+        producers.emplace_back([p, &running, &SIG]
+                               {
+                                   for (int i = 1; i <= PER_PRODUCER; ++i)
+                                       ring.log(LogLevel::INFO, &SIG, "c", uint64_t(p) * PER_PRODUCER + i);
+                                   running.fetch_sub(1); });
+    while (running.load() != 0)
+        ring.drain(logger);
+    for (auto &t : producers)
+        t.join();
+    ring.drain(logger);
+
+    REQUIRE(d.timestamps.size() + ring.dropped() == size_t(PRODUCERS) * PER_PRODUCER);
+    std::vector<bool> seen(PRODUCERS * PER_PRODUCER + 1, false);
+    bool unique = true;
+    for (uint64_t ts : d.timestamps)
+    {
+        unique = unique && !seen[ts];
+        seen[ts] = true;
+    }
+    REQUIRE(unique);
+}
@@ -0,0 +1,98 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+
+#include <memory>
+
+using namespace LogAnywhere;
+
+static void countingHandler(const LogMessage &, void *ctx)
+{
+    ++*static_cast<int *>(ctx);
+}
+
+// Tests matchesTagPattern on dotted names:
+// exact segments, single-segment "*", trailing "*" subtrees and bad input
+TEST_CASE("matchesTagPattern handles dotted wildcards", "[TagPattern]")
+{
+    REQUIRE(matchesTagPattern("net.tcp.rx", "net.tcp.rx"));
+    REQUIRE_FALSE(matchesTagPattern("net.tcp", "net.tcp.rx"));
+    REQUIRE_FALSE(matchesTagPattern("net.tcp.rx", "net.tcp"));
+    REQUIRE_FALSE(matchesTagPattern("net.tc", "net.tcp"));
+
+    REQUIRE(matchesTagPattern("net.*", "net.tcp"));
+    REQUIRE(matchesTagPattern("net.*", "net.tcp.rx"));
+    REQUIRE_FALSE(matchesTagPattern("net.*", "net"));
+    REQUIRE_FALSE(matchesTagPattern("net.*", "network.tcp"));
+
+    REQUIRE(matchesTagPattern("net.*.rx", "net.udp.rx"));
+    REQUIRE_FALSE(matchesTagPattern("net.*.rx", "net.udp.tx"));
+    REQUIRE_FALSE(matchesTagPattern("net.*.rx", "net.rx"));
+
+    REQUIRE(matchesTagPattern("*", "OTA"));
+    REQUIRE(matchesTagPattern("*", "a.b.c"));
+    REQUIRE_FALSE(matchesTagPattern("*", ""));
+    REQUIRE_FALSE(matchesTagPattern(nullptr, "OTA"));
+}
+
+// Tests wildcard registration:
+// 1) existing matching Tags are subscribed at registration, others are not
+// 2) Tags created after registration join matching handlers
+// 3) deleting the handler, or an earlier one (compaction), keeps Tags consistent
+TEST_CASE("Pattern handlers are resolved into Tag subscriber lists", "[TagPattern][HandlerManager]")
+{
+    Tag RX("net.tcp.rx"), TX("net.tcp.tx"), DB("db.query"), NET("net");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    int netHits = 0, otherHits = 0;
+    static const char *const netPatterns[] = {"net.*"};
+
+    const Tag *db[] = {&DB};
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, countingHandler, &otherHits, db, 1, "db"));
+    REQUIRE(mgr.registerHandlerForPatterns(LogLevel::TRACE, countingHandler, &netHits, netPatterns, 1, "net"));
+
+    REQUIRE(RX.handlerCount == 1);
+    REQUIRE(TX.handlerCount == 1);
+    REQUIRE(NET.handlerCount == 0);
+    REQUIRE(DB.handlerCount == 1);
+
+    logger.log(LogLevel::INFO, &RX, "rx");
+    logger.log(LogLevel::INFO, &NET, "root");
+    REQUIRE(netHits == 1);
+
+    SECTION("Tags created later join matching handlers")
+    {
+        auto late = std::make_unique<Tag>("net.udp.rx");
+        Tag unrelated("disk.io");
+        REQUIRE(late->handlerCount == 1);
+        REQUIRE(unrelated.handlerCount == 0);
+        logger.log(LogLevel::INFO, late.get(), "late");
+        REQUIRE(netHits == 2);
+        REQUIRE(mgr.deleteHandlerByName("net"));
+        REQUIRE(late->handlerCount == 0);
+    }
+
+    SECTION("compaction re-points pattern subscriptions")
+    {
+        REQUIRE(mgr.deleteHandlerByName("db"));
+        REQUIRE(RX.handlerCount == 1);
+        logger.log(LogLevel::INFO, &TX, "tx");
+        REQUIRE(netHits == 2);
+        REQUIRE(otherHits == 0);
+
+        size_t count = 0;
+        const HandlerEntry *entries = mgr.listHandlers(count);
+        REQUIRE(count == 1);
+        REQUIRE(RX.handlers[0] == &entries[0]);
+    }
+
+    SECTION("clearHandlers prunes pattern subscriptions")
+    {
+        mgr.clearHandlers();
+        REQUIRE(RX.handlerCount == 0);
+        REQUIRE(TX.handlerCount == 0);
+        Tag after("net.tcp.err");
+        REQUIRE(after.handlerCount == 0);
+    }
+}
@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "../include/LogAnywhere.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace LogAnywhere;
+
+static Tag STATIC_BOOT("sys.boot");
+
+// The perfect hash is built and queried entirely at compile time
+static constexpr const char *kNames[] = {"net.tcp", "net.udp", "db", "ota", "sys.boot", "sys.power"};
+static constexpr PerfectTagHash<6> kIndex(kNames);
+static_assert(kIndex.find("db") == 2, "compile-time lookup");
+static_assert(kIndex.find("sys.power") == 5, "compile-time lookup");
+static_assert(kIndex.find("net") == PerfectTagHash<6>::NOT_FOUND, "compile-time miss");
+
+// Tests the global TagRegistry:
+// 1) every Tag, static or dynamic, gets a dense ID and is found by name
+// 2) IDs of destroyed Tags are reused and their names stop resolving
+// 3) a full registry hands out ID 0 without breaking lookups of others
+TEST_CASE("TagRegistry assigns dense IDs and finds Tags by name", "[TagRegistry]")
+{
+    REQUIRE(findTag("sys.boot") == &STATIC_BOOT);
+    REQUIRE(tagById(STATIC_BOOT.id) == &STATIC_BOOT);
+    REQUIRE(STATIC_BOOT.id != 0);
+
+    const size_t before = detail::tagRegistry.size();
+    {
+        Tag a("cfg.a"), b("cfg.b");
+        REQUIRE(a.id != 0);
+        REQUIRE(b.id != a.id);
+        REQUIRE(detail::tagRegistry.size() == before + 2);
+        REQUIRE(findTag("cfg.a") == &a);
+        REQUIRE(findTag("cfg.b") == &b);
+        REQUIRE(findTag("cfg.c") == nullptr);
+        REQUIRE(findTag(nullptr) == nullptr);
+    }
+    REQUIRE(findTag("cfg.a") == nullptr);
+    REQUIRE(detail::tagRegistry.size() == before);
+
+    SECTION("freed IDs are reused")
+    {
+        uint16_t firstId;
+        {
+            Tag t("reuse.one");
+            firstId = t.id;
+        }
+        Tag again("reuse.two");
+        REQUIRE(again.id == firstId);
+    }
+
+    SECTION("many names survive interleaved removals")
+    {
+        std::vector<std::string> names;
+        std::vector<std::unique_ptr<Tag>> tags;
+        const size_t room = TagRegistry::MAX_TAGS - before;
+        for (size_t i = 0; i < room; ++i)
+            names.push_back("dyn." + std::to_string(i));
+        for (size_t i = 0; i < room; ++i)
+            tags.push_back(std::make_unique<Tag>(names[i].c_str()));
+        for (size_t i = 0; i < room; i += 3)
+            tags[i].reset();
+        for (size_t i = 0; i < room; ++i)
+        {
+            Tag *found = findTag(names[i].c_str());
+            REQUIRE(found == tags[i].get());
+            if (found)
+                REQUIRE(tagById(found->id) == found);
+        }
+    }
+
+    SECTION("a full registry gives ID 0")
+    {
+        std::vector<std::unique_ptr<Tag>> tags;
+        for (size_t i = before; i < TagRegistry::MAX_TAGS; ++i)
+            tags.push_back(std::make_unique<Tag>("fill"));
+        Tag overflow("overflow");
+        REQUIRE(overflow.id == 0);
+        REQUIRE(findTag("overflow") == nullptr);
+        REQUIRE(findTag("sys.boot") == &STATIC_BOOT);
+        REQUIRE(findTag("fill") != nullptr);
+    }
+}
+
+// Tests PerfectTagHash at run time against every name and some misses
+TEST_CASE("PerfectTagHash finds every name exactly", "[TagRegistry][PerfectTagHash]")
+{
+    static const char *const many[] = {
+        "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p",
+        "net.tcp.rx", "net.tcp.tx", "net.udp.rx", "net.udp.tx", "db.read", "db.write",
+        "ota.fetch", "ota.verify", "ota.apply", "sys.boot", "sys.power", "sys.clock"};
+    constexpr size_t N = sizeof(many) / sizeof(many[0]);
+    static constexpr PerfectTagHash<N> index(many);
+    for (size_t i = 0; i < N; ++i)
+        REQUIRE(index.find(many[i]) == i);
+    REQUIRE(index.find("net") == N);
+    REQUIRE(index.find("") == N);
+    REQUIRE(index.find("sys.clocks") == N);
+}
@@ -0,0 +1,188 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#define LOGANYWHERE_ENABLE_THREAD_CONTEXT 1
+#include "../include/LogAnywhere.h"
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LogAnywhere;
+
+struct Capture
+{
+    const char *lastPtr = nullptr;
+    std::vector<std::string> messages;
+};
+
+static void captureHandler(const LogMessage &msg, void *ctx)
+{
+    auto *c = static_cast<Capture *>(ctx);
+    c->lastPtr = msg.message;
+    c->messages.emplace_back(msg.message);
+}
+
+// Tests the logf() scratch buffer:
+// 1) the formatted text lives in the thread's scratch, not a stack buffer
+// 2) messages longer than the old 256-byte buffer are kept
+TEST_CASE("logf formats into the thread's scratch buffer", "[ThreadContext]")
+{
+    Tag APP("APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    Capture cap;
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, captureHandler, &cap, tags, 1));
+
+    logger.logf(LogLevel::INFO, &APP, "value=%d", 42);
+    REQUIRE(cap.messages.back() == "value=42");
+    REQUIRE(cap.lastPtr == threadContext()->scratch);
+
+    std::string longText(400, 'x');
+    logger.logf(LogLevel::INFO, &APP, "%s", longText.c_str());
+    REQUIRE(cap.messages.back() == longText);
+}
+
+struct Nested
+{
+    const Logger *logger;
+    const Tag *inner;
+    std::string outerBefore, outerAfter;
+};
+
+static void nestingHandler(const LogMessage &msg, void *ctx)
+{
+    auto *n = static_cast<Nested *>(ctx);
+    n->outerBefore = msg.message;
+    n->logger->logf(LogLevel::INFO, n->inner, "inner %d", 2);
+    n->outerAfter = msg.message;
+}
+
+// Tests that a handler calling logf() does not overwrite the message
+// it is handling: the nested call falls back to its own buffer
+TEST_CASE("Nested logf keeps the outer message intact", "[ThreadContext]")
+{
+    Tag OUTER("OUTER");
+    Tag INNER("INNER");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *outerTags[] = {&OUTER};
+    const Tag *innerTags[] = {&INNER};
+    Nested nested{&logger, &INNER, "", ""};
+    Capture inner;
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, nestingHandler, &nested, outerTags, 1));
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, captureHandler, &inner, innerTags, 1));
+
+    logger.logf(LogLevel::INFO, &OUTER, "outer %d", 1);
+    REQUIRE(nested.outerBefore == "outer 1");
+    REQUIRE(nested.outerAfter == "outer 1");
+    REQUIRE(inner.messages.back() == "inner 2");
+    REQUIRE(inner.lastPtr != threadContext()->scratch);
+    REQUIRE(threadContext()->scratchDepth == 0);
+}
+
+// Tests the cached per-thread values:
+// 1) thread IDs are stable within a thread and differ between threads
+// 2) sequence numbers are unique across threads and increase per thread
+TEST_CASE("Thread IDs and sequences are per thread", "[ThreadContext]")
+{
+    const uint64_t mainId = contextThreadId();
+    REQUIRE(mainId == contextThreadId());
+    REQUIRE(mainId == threadContext()->threadId);
+
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 3 * LOGANYWHERE_SEQUENCE_BLOCK;
+    uint64_t ids[THREADS] = {};
+    std::vector<uint64_t> seqs[THREADS];
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        workers.emplace_back([t, &ids, &seqs]
+                             {
+                                 ids[t] = contextThreadId();
+                                 for (int i = 0; i < PER_THREAD; ++i)
+                                     seqs[t].push_back(contextSequence()); });
+    }
+    for (auto &w : workers)
+        w.join();
+
+    std::set<uint64_t> uniqueIds{mainId};
+    std::set<uint64_t> uniqueSeqs;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        uniqueIds.insert(ids[t]);
+        for (int i = 0; i < PER_THREAD; ++i)
+        {
+            REQUIRE(seqs[t][i] != 0);
+            if (i > 0)
+                REQUIRE(seqs[t][i] > seqs[t][i - 1]);
+            uniqueSeqs.insert(seqs[t][i]);
+        }
+    }
+    REQUIRE(uniqueIds.size() == THREADS + 1);
+    REQUIRE(uniqueSeqs.size() == size_t(THREADS) * PER_THREAD);
+}
+
+static void releaseBuffer(void *buffer, void *ctx)
+{
+    *static_cast<void **>(ctx) = buffer;
+}
+
+// Tests that an attached async buffer is handed back when its thread exits
+TEST_CASE("Async buffer is released at thread exit", "[ThreadContext]")
+{
+    int buffer = 0;
+    void *released = nullptr;
+    bool releasedEarly = true;
+    std::thread([&]
+                {
+                    threadContext()->attachAsyncBuffer(&buffer, releaseBuffer, &released);
+                    releasedEarly = released != nullptr; })
+        .join();
+    REQUIRE_FALSE(releasedEarly);
+    REQUIRE(released == &buffer);
+}
+
+struct LateLogger
+{
+    const Logger *logger = nullptr;
+    const Tag *tag = nullptr;
+    static inline bool sawNoContext = false;
+
+    ~LateLogger()
+    {
+        sawNoContext = threadContext() == nullptr;
+        if (logger)
+            logger->logf(LogLevel::INFO, tag, "late %d", 7);
+    }
+};
+
+// Tests that logging from a thread_local destructor that runs after the
+// context was destroyed still works, using the stack buffer
+TEST_CASE("logf after the context is torn down", "[ThreadContext]")
+{
+    Tag APP("APP");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&APP};
+    Capture cap;
+    REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, captureHandler, &cap, tags, 1));
+
+    LateLogger::sawNoContext = false;
+    std::thread([&]
+                {
+                    // Constructed before the context, so destroyed after it
+                    static thread_local LateLogger late;
+                    late.logger = &logger;
+                    late.tag = &APP;
+                    logger.logf(LogLevel::INFO, &APP, "early %d", 1); })
+        .join();
+
+    REQUIRE(LateLogger::sawNoContext);
+    REQUIRE(cap.messages.size() == 2);
+    REQUIRE(cap.messages[0] == "early 1");
+    REQUIRE(cap.messages[1] == "late 7");
+    REQUIRE(contextSequence() != 0);
+}
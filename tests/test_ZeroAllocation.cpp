@@ -0,0 +1,269 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+// Exercise the optional instrumentation too: it must not allocate either
+#define LOGANYWHERE_ENABLE_STATS 1
+#define LOGANYWHERE_ENABLE_HANDLER_LATENCY 1
+
+#include "../include/LogAnywhere.h"
+#include "../include/Compression.h"
+#include "../include/RecordFrame.h"
+#include "../include/PersistentRing.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <execinfo.h>
+#include <unistd.h>
+
+using namespace LogAnywhere;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Allocation tracker: malloc and operator new are interposed for the whole
+// test binary.  Allocations are only recorded while a scope is armed on the
+// current thread, so Catch2's own bookkeeping never counts.
+// ─────────────────────────────────────────────────────────────────────────────
+
+extern "C" void *__libc_malloc(size_t);
+extern "C" void *__libc_calloc(size_t, size_t);
+extern "C" void *__libc_realloc(void *, size_t);
+extern "C" void *__libc_memalign(size_t, size_t);
+extern "C" void __libc_free(void *);
+
+namespace
+{
+    struct AllocationSite
+    {
+        const char *kind;
+        size_t size;
+        void *frames[12];
+        int depth;
+    };
+
+    constexpr int MAX_SITES = 8;
+    thread_local bool armed = false;
+    thread_local bool inHook = false;
+    thread_local size_t allocationCount = 0;
+    thread_local AllocationSite sites[MAX_SITES];
+
+    void noteAllocation(const char *kind, size_t size)
+    {
+        if (!armed || inHook)
+            return;
+        inHook = true;
+        if (allocationCount < MAX_SITES)
+        {
+            AllocationSite &s = sites[allocationCount];
+            s.kind = kind;
+            s.size = size;
+            s.depth = backtrace(s.frames, 12);
+        }
+        ++allocationCount;
+        inHook = false;
+    }
+
+    /// Prints every recorded call site to stderr without allocating.
+    void reportSites(const char *what)
+    {
+        std::fprintf(stderr, "\n%zu heap allocation(s) during \"%s\":\n", allocationCount, what);
+        size_t shown = allocationCount < MAX_SITES ? allocationCount : MAX_SITES;
+        for (size_t i = 0; i < shown; ++i)
+        {
+            std::fprintf(stderr, "  #%zu %s(%zu) at:\n", i, sites[i].kind, sites[i].size);
+            std::fflush(stderr);
+            backtrace_symbols_fd(sites[i].frames + 1, sites[i].depth - 1, STDERR_FILENO);
+        }
+    }
+
+    /**
+     * @brief Runs @p body with the tracker armed.
+     * @param what   Label used in the violation report.
+     * @param body   Code under test.
+     * @param report Print call sites if anything allocated.
+     * @return Number of heap allocations @p body made on this thread.
+     */
+    template <typename Body>
+    size_t allocationsDuring(const char *what, Body body, bool report = true)
+    {
+        static bool primed = false;
+        if (!primed)
+        {
+            // backtrace() loads the unwinder lazily, which itself allocates
+            void *frames[2];
+            backtrace(frames, 2);
+            primed = true;
+        }
+        allocationCount = 0;
+        armed = true;
+        body();
+        armed = false;
+        if (allocationCount && report)
+            reportSites(what);
+        return allocationCount;
+    }
+}
+
+extern "C" void *malloc(size_t n)
+{
+    noteAllocation("malloc", n);
+    return __libc_malloc(n);
+}
+
+extern "C" void *calloc(size_t n, size_t size)
+{
+    noteAllocation("calloc", n * size);
+    return __libc_calloc(n, size);
+}
+
+extern "C" void *realloc(void *p, size_t n)
+{
+    noteAllocation("realloc", n);
+    return __libc_realloc(p, n);
+}
+
+extern "C" void free(void *p)
+{
+    __libc_free(p);
+}
+
+void *operator new(size_t n)
+{
+    noteAllocation("operator new", n);
+    if (void *p = __libc_malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t n)
+{
+    noteAllocation("operator new[]", n);
+    if (void *p = __libc_malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(size_t n, std::align_val_t a)
+{
+    noteAllocation("operator new(align)", n);
+    if (void *p = __libc_memalign(static_cast<size_t>(a), n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t n, std::align_val_t a) { return operator new(n, a); }
+void operator delete(void *p) noexcept { __libc_free(p); }
+void operator delete[](void *p) noexcept { __libc_free(p); }
+void operator delete(void *p, size_t) noexcept { __libc_free(p); }
+void operator delete[](void *p, size_t) noexcept { __libc_free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { __libc_free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { __libc_free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { __libc_free(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { __libc_free(p); }
+
+static void countingHandler(const LogMessage &msg, void *ctx)
+{
+    *static_cast<size_t *>(ctx) += msg.message[0] != '\0';
+}
+
+// Verifies the tracker itself: an allocation inside an armed scope is caught
+TEST_CASE("Allocation tracker detects heap use", "[ZeroAllocation]")
+{
+    size_t n = allocationsDuring("deliberate allocation", []
+                                 {
+        int *volatile p = new int(7);
+        delete p;
+        void *volatile q = std::malloc(16);
+        std::free(q); },
+                                 false);
+    REQUIRE(std::string(sites[0].kind) == "operator new");
+    REQUIRE(sites[1].size == 16);
+    REQUIRE(n == 2);
+}
+
+// Tests that the hot path never touches the heap once set up:
+// 1) log with no subscribers, and fan-out to several handlers
+// 2) logf with integer, string and floating-point formats
+// 3) dispatch with disabled and level-filtered handlers, plus stats/latency reads
+// 4) byte-sink stages (compressor, framing) and PersistentRing appends
+TEST_CASE("Hot path performs zero heap allocations", "[ZeroAllocation]")
+{
+    Tag NET("NET"), QUIET("QUIET");
+    HandlerManager mgr;
+    Logger logger(&mgr);
+    const Tag *tags[] = {&NET};
+    size_t delivered = 0;
+
+    // Setup is allowed to do anything; only steady state is measured
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(mgr.registerHandlerForTags(i == 3 ? LogLevel::ERR : LogLevel::TRACE, countingHandler,
+                                           &delivered, tags, 1));
+    logger.log(LogLevel::INFO, &NET, "warm up thread-local state");
+
+    SECTION("log")
+    {
+        REQUIRE(allocationsDuring("log", [&]
+                                  {
+            for (int i = 0; i < 1000; ++i)
+            {
+                logger.log(LogLevel::INFO, &NET, "steady state");
+                logger.log(LogLevel::INFO, &QUIET, "nobody listens");
+            } }) == 0);
+        REQUIRE(delivered >= 3000);
+    }
+
+    SECTION("logf")
+    {
+        REQUIRE(allocationsDuring("logf", [&]
+                                  {
+            for (int i = 0; i < 200; ++i)
+            {
+                logger.logf(LogLevel::WARN, &NET, "rssi=%d peer=%s", -60 - i % 20, "node-7");
+                logger.logf(LogLevel::INFO, &NET, "temp=%.2f load=%u%%", 21.5 + i, 42u);
+            } }) == 0);
+    }
+
+    SECTION("dispatch with skipped handlers and instrumentation")
+    {
+        size_t count = 0;
+        const_cast<HandlerEntry *>(mgr.listHandlers(count))[0].setEnabled(false);
+        uint64_t p99 = 0;
+        REQUIRE(allocationsDuring("dispatch", [&]
+                                  {
+            for (int i = 0; i < 500; ++i)
+                logger.log(LogLevel::DEBUG, &NET, "filtered for one handler");
+            RoutingStatsSnapshot snap = mgr.snapshotStats();
+            p99 = mgr.handlerLatency(2)->p99() + snap.delivered; }) == 0);
+        REQUIRE(p99 > 0);
+    }
+
+    SECTION("byte sinks and persistent ring")
+    {
+        std::string path = "/tmp/loganywhere_zeroalloc_" + std::to_string(getpid()) + ".ring";
+        std::remove(path.c_str());
+        PersistentRing ring;
+        REQUIRE(ring.open(path.c_str(), 16));
+        const Tag *ringTags[] = {&QUIET};
+        REQUIRE(mgr.registerHandlerForTags(LogLevel::TRACE, PersistentRing::logHandler, &ring, ringTags, 1));
+
+        static size_t framedBytes = 0;
+        FrameEncoder framer([](const uint8_t *, size_t len, void *)
+                            { framedBytes += len; },
+                            nullptr);
+        static LzCompressor lz(FrameEncoder::sinkAdapter, &framer);
+
+        REQUIRE(allocationsDuring("byte sinks", [&]
+                                  {
+            for (int i = 0; i < 100; ++i)
+            {
+                logger.log(LogLevel::INFO, &QUIET, "persisted");
+                lz.write("compress me, compress me, compress me\n", 38);
+            }
+            lz.flush(); }) == 0);
+        REQUIRE(framedBytes > 0);
+        REQUIRE(ring.lastId() == 100);
+
+        ring.close();
+        std::remove(path.c_str());
+    }
+}
@@ -118,7 +118,7 @@ TEST_CASE("Logger::log full dispatch & filtering suite", "[Logger]")
         auto entries = mgr.listHandlers(cnt);
         auto *entry = const_cast<HandlerEntry *>(&entries[0]);
 
-        entry->enabled = false;
+        entry->setEnabled(false);
 
         logger.log(LogLevel::INFO, &CORE, "Hello");
         // Handler is disabled, so it should not run
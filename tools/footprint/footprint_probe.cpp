@@ -0,0 +1,48 @@
+/**
+ * @file footprint_probe.cpp
+ * @brief Minimal program used to measure LogAnywhere's RAM and code cost.
+ *
+ * Built once per configuration by the loganywhere_footprint target, with
+ * the configuration macros passed as compile definitions.  It touches the
+ * whole public API once so the linker keeps the code a real firmware would
+ * carry, then prints the sizes of the core types.  FOOTPRINT_BASELINE
+ * builds the same program without LogAnywhere, so the report can subtract
+ * the C runtime.
+ */
+
+#include <cstdio>
+
+#ifndef FOOTPRINT_BASELINE
+#include "../../include/LogAnywhere.h"
+
+using namespace LogAnywhere;
+
+static Tag TAG_APP("APP");
+static Tag TAG_NET("NET");
+
+static void sink(const LogMessage &msg, void *ctx)
+{
+    *static_cast<unsigned *>(ctx) += msg.message[0];
+}
+#endif
+
+int main(int argc, char **)
+{
+#ifndef FOOTPRINT_BASELINE
+    unsigned seen = 0;
+    const Tag *tags[] = {&TAG_APP, &TAG_NET};
+    registerHandler(LogLevel::INFO, sink, &seen, tags, 2, "probe");
+    log(LogLevel::WARN, &TAG_APP, "probe", 1);
+    logf(LogLevel::INFO, &TAG_NET, "probe %d", argc);
+    disableHandler("probe");
+    enableHandler(static_cast<uint16_t>(1));
+    deleteHandlerByName("probe");
+    clearHandlers();
+
+    std::printf("HandlerManager=%zu Tag=%zu HandlerEntry=%zu Logger=%zu seen=%u\n",
+                sizeof(HandlerManager), sizeof(Tag), sizeof(HandlerEntry), sizeof(Logger), seen);
+#else
+    std::printf("HandlerManager=0 Tag=0 HandlerEntry=0 Logger=0 seen=%d\n", argc);
+#endif
+    return 0;
+}
@@ -0,0 +1,58 @@
+# Prints the footprint table for the probes built by loganywhere_footprint.
+#
+# Inputs (-D):
+#   PROBES     ;-list of name=path pairs, the first one being the baseline
+#   SIZE_TOOL  path to a Berkeley-format `size`
+#   OUTPUT_CSV file receiving the same data as CSV
+
+function(probe_sizes path out_text out_data out_bss)
+    execute_process(COMMAND ${SIZE_TOOL} ${path} OUTPUT_VARIABLE out RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "size failed on ${path}")
+    endif()
+    string(REGEX MATCH "\n[ \t]*([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)" _ "${out}")
+    set(${out_text} ${CMAKE_MATCH_1} PARENT_SCOPE)
+    set(${out_data} ${CMAKE_MATCH_2} PARENT_SCOPE)
+    set(${out_bss} ${CMAKE_MATCH_3} PARENT_SCOPE)
+endfunction()
+
+function(probe_types path out)
+    execute_process(COMMAND ${path} OUTPUT_VARIABLE line OUTPUT_STRIP_TRAILING_WHITESPACE)
+    string(REGEX MATCH "HandlerManager=([0-9]+) Tag=([0-9]+) HandlerEntry=([0-9]+) Logger=([0-9]+)" _ "${line}")
+    set(${out} "${CMAKE_MATCH_1};${CMAKE_MATCH_2};${CMAKE_MATCH_3};${CMAKE_MATCH_4}" PARENT_SCOPE)
+endfunction()
+
+set(csv "config,sizeof_HandlerManager,sizeof_Tag,sizeof_HandlerEntry,sizeof_Logger,text,data,bss,text_delta,data_delta,bss_delta\n")
+set(table "")
+string(APPEND table "| config | HandlerManager | Tag | HandlerEntry | Logger | text | data | bss | Δtext | Δdata | Δbss |\n")
+string(APPEND table "|:-------|---:|---:|---:|---:|---:|---:|---:|---:|---:|---:|\n")
+
+set(first TRUE)
+foreach(pair IN LISTS PROBES)
+    string(REPLACE "=" ";" parts "${pair}")
+    list(GET parts 0 name)
+    list(GET parts 1 path)
+    probe_sizes(${path} text data bss)
+    probe_types(${path} types)
+    list(GET types 0 mgr)
+    list(GET types 1 tag)
+    list(GET types 2 entry)
+    list(GET types 3 logger)
+    if(first)
+        set(base_text ${text})
+        set(base_data ${data})
+        set(base_bss ${bss})
+        set(first FALSE)
+    endif()
+    math(EXPR dt "${text} - ${base_text}")
+    math(EXPR dd "${data} - ${base_data}")
+    math(EXPR db "${bss} - ${base_bss}")
+    string(APPEND table "| ${name} | ${mgr} | ${tag} | ${entry} | ${logger} | ${text} | ${data} | ${bss} | ${dt} | ${dd} | ${db} |\n")
+    string(APPEND csv "${name},${mgr},${tag},${entry},${logger},${text},${data},${bss},${dt},${dd},${db}\n")
+endforeach()
+
+message("${table}")
+if(OUTPUT_CSV)
+    file(WRITE ${OUTPUT_CSV} "${csv}")
+    message("CSV written to ${OUTPUT_CSV}")
+endif()